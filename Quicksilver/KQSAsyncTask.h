@@ -0,0 +1,96 @@
+//
+//  KQSAsyncTask.h
+//  Quicksilver
+//
+//  Created by William Towe on 10/19/26.
+//  Copyright © 2021 Kosoku Interactive, LLC. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ The error domain for errors passed to the completion block of a KQSAsyncTask.
+ */
+FOUNDATION_EXPORT NSErrorDomain const KQSAsyncTaskErrorDomain;
+
+/**
+ Enum describing the possible error codes in the KQSAsyncTaskErrorDomain.
+ */
+typedef NS_ERROR_ENUM(KQSAsyncTaskErrorDomain, KQSAsyncTaskErrorCode) {
+    /**
+     The task was cancelled before all items completed.
+     */
+    KQSAsyncTaskErrorCodeCancelled = 1,
+    /**
+     An item did not invoke its completion block within the timeout. The index of the item is available in the error's userInfo using KQSAsyncTaskErrorIndexKey.
+     */
+    KQSAsyncTaskErrorCodeTimedOut = 2
+};
+
+/**
+ The userInfo key for the NSNumber index of the item that timed out.
+ */
+FOUNDATION_EXPORT NSString *const KQSAsyncTaskErrorIndexKey;
+
+/**
+ Typedef for the block that is invoked once for each item. The block must invoke *completion* exactly once, on any thread, when the item's value is available. Passing nil stores [NSNull null] in the results, matching the synchronous KQS_map: methods.
+ */
+typedef void(^KQSAsyncTaskItemBlock)(NSInteger index, void(^completion)(id _Nullable value));
+/**
+ Typedef for the block invoked once the task finishes. On success *values* contains one value per item in index order and *error* is nil, otherwise *values* is nil and *error* describes why the task stopped.
+ */
+typedef void(^KQSAsyncTaskCompletionBlock)(NSArray * _Nullable values, NSError * _Nullable error);
+
+/**
+ KQSAsyncTask runs an asynchronous block for a fixed number of items on a dispatch queue, keeping at most maxConcurrency items in flight at once. A new item is only started when an earlier one completes, so slow item blocks apply back pressure instead of flooding the queue. Results are assembled in index order regardless of the order in which items complete.
+
+ The KQS_async... methods of the collection categories are built on top of this class, and return the task so it can be cancelled.
+ */
+@interface KQSAsyncTask : NSObject
+
+/**
+ Whether the task has finished, either successfully or with an error.
+ */
+@property (readonly,assign,nonatomic,getter=isFinished) BOOL finished;
+/**
+ Whether the task was cancelled.
+ */
+@property (readonly,assign,nonatomic,getter=isCancelled) BOOL cancelled;
+
+/**
+ Creates, starts and returns a new task.
+
+ @param count The number of items
+ @param maxConcurrency The maximum number of items in flight at once, values <= 0 use the active processor count
+ @param timeout The maximum number of seconds each item may take to invoke its completion block, values <= 0 mean no timeout
+ @param queue The queue on which item blocks and the completion block are invoked, nil means the default priority global queue
+ @param block The block to invoke for each item
+ @param completion The block to invoke when the task finishes
+ @return The started task
+ @exception NSException Thrown if block or completion are nil
+ */
++ (instancetype)taskWithCount:(NSInteger)count maxConcurrency:(NSInteger)maxConcurrency timeout:(NSTimeInterval)timeout queue:(nullable dispatch_queue_t)queue block:(KQSAsyncTaskItemBlock)block completion:(KQSAsyncTaskCompletionBlock)completion;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/**
+ Cancel the task. No new items are started and the completion block is invoked with a KQSAsyncTaskErrorCodeCancelled error. Items that are already in flight are not interrupted, their values are discarded. Has no effect if the task has already finished.
+ */
+- (void)cancel;
+
+@end
+
+NS_ASSUME_NONNULL_END
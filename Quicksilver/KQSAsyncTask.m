@@ -0,0 +1,178 @@
+//
+//  KQSAsyncTask.m
+//  Quicksilver
+//
+//  Created by William Towe on 10/19/26.
+//  Copyright © 2021 Kosoku Interactive, LLC. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#import "KQSAsyncTask.h"
+
+NSErrorDomain const KQSAsyncTaskErrorDomain = @"com.kosoku.quicksilver.async";
+NSString *const KQSAsyncTaskErrorIndexKey = @"KQSAsyncTaskErrorIndexKey";
+
+@interface KQSAsyncTask ()
+@property (assign,nonatomic) NSInteger count;
+@property (assign,nonatomic) NSInteger maxConcurrency;
+@property (assign,nonatomic) NSTimeInterval timeout;
+@property (strong,nonatomic) dispatch_queue_t queue;
+// all mutable state below is only touched on this serial queue
+@property (strong,nonatomic) dispatch_queue_t stateQueue;
+@property (copy,nonatomic,nullable) KQSAsyncTaskItemBlock block;
+@property (copy,nonatomic,nullable) KQSAsyncTaskCompletionBlock completion;
+@property (strong,nonatomic) NSMutableArray *values;
+@property (strong,nonatomic) NSMutableIndexSet *completedIndexes;
+@property (assign,nonatomic) NSInteger nextIndex;
+
+- (void)_startItemAtIndex:(NSInteger)index;
+- (void)_completeItemAtIndex:(NSInteger)index value:(nullable id)value;
+- (void)_finishWithError:(nullable NSError *)error;
+@end
+
+@implementation KQSAsyncTask
+
+@synthesize finished = _finished, cancelled = _cancelled;
+
+- (instancetype)_initWithCount:(NSInteger)count maxConcurrency:(NSInteger)maxConcurrency timeout:(NSTimeInterval)timeout queue:(dispatch_queue_t)queue block:(KQSAsyncTaskItemBlock)block completion:(KQSAsyncTaskCompletionBlock)completion {
+    if (!(self = [super init]))
+        return nil;
+
+    _count = MAX(count, 0);
+    _maxConcurrency = maxConcurrency > 0 ? maxConcurrency : MAX((NSInteger)NSProcessInfo.processInfo.activeProcessorCount, 1);
+    _timeout = timeout;
+    _queue = queue ?: dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0);
+    _stateQueue = dispatch_queue_create("com.kosoku.quicksilver.async.state", DISPATCH_QUEUE_SERIAL);
+    _block = [block copy];
+    _completion = [completion copy];
+    _values = [[NSMutableArray alloc] initWithCapacity:_count];
+    _completedIndexes = [[NSMutableIndexSet alloc] init];
+
+    for (NSInteger i=0; i<_count; i++) {
+        [_values addObject:[NSNull null]];
+    }
+
+    return self;
+}
+
++ (instancetype)taskWithCount:(NSInteger)count maxConcurrency:(NSInteger)maxConcurrency timeout:(NSTimeInterval)timeout queue:(dispatch_queue_t)queue block:(KQSAsyncTaskItemBlock)block completion:(KQSAsyncTaskCompletionBlock)completion {
+    NSParameterAssert(block);
+    NSParameterAssert(completion);
+
+    KQSAsyncTask *retval = [[self alloc] _initWithCount:count maxConcurrency:maxConcurrency timeout:timeout queue:queue block:block completion:completion];
+
+    dispatch_async(retval.stateQueue, ^{
+        if (retval.count == 0) {
+            [retval _finishWithError:nil];
+            return;
+        }
+
+        while (retval.nextIndex < MIN(retval.count, retval.maxConcurrency)) {
+            [retval _startItemAtIndex:retval.nextIndex];
+        }
+    });
+
+    return retval;
+}
+
+- (void)cancel {
+    dispatch_async(self.stateQueue, ^{
+        if (self->_finished) {
+            return;
+        }
+
+        self->_cancelled = YES;
+
+        [self _finishWithError:[NSError errorWithDomain:KQSAsyncTaskErrorDomain code:KQSAsyncTaskErrorCodeCancelled userInfo:nil]];
+    });
+}
+
+- (BOOL)isFinished {
+    __block BOOL retval;
+
+    dispatch_sync(self.stateQueue, ^{
+        retval = self->_finished;
+    });
+
+    return retval;
+}
+- (BOOL)isCancelled {
+    __block BOOL retval;
+
+    dispatch_sync(self.stateQueue, ^{
+        retval = self->_cancelled;
+    });
+
+    return retval;
+}
+
+// must be called on stateQueue
+- (void)_startItemAtIndex:(NSInteger)index {
+    KQSAsyncTaskItemBlock block = self.block;
+
+    self.nextIndex = index + 1;
+
+    dispatch_async(self.queue, ^{
+        block(index, ^(id value) {
+            [self _completeItemAtIndex:index value:value];
+        });
+    });
+
+    if (self.timeout > 0) {
+        dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(self.timeout * NSEC_PER_SEC)), self.stateQueue, ^{
+            if (self->_finished ||
+                [self.completedIndexes containsIndex:index]) {
+                return;
+            }
+
+            [self _finishWithError:[NSError errorWithDomain:KQSAsyncTaskErrorDomain code:KQSAsyncTaskErrorCodeTimedOut userInfo:@{KQSAsyncTaskErrorIndexKey: @(index)}]];
+        });
+    }
+}
+- (void)_completeItemAtIndex:(NSInteger)index value:(id)value {
+    dispatch_async(self.stateQueue, ^{
+        // late values from cancelled or timed out tasks, and duplicate invocations of completion, are ignored
+        if (self->_finished ||
+            [self.completedIndexes containsIndex:index]) {
+            return;
+        }
+
+        [self.completedIndexes addIndex:index];
+        self.values[index] = value ?: [NSNull null];
+
+        if ((NSInteger)self.completedIndexes.count == self.count) {
+            [self _finishWithError:nil];
+        }
+        else if (self.nextIndex < self.count) {
+            [self _startItemAtIndex:self.nextIndex];
+        }
+    });
+}
+// must be called on stateQueue
+- (void)_finishWithError:(NSError *)error {
+    KQSAsyncTaskCompletionBlock completion = self.completion;
+    NSArray *values = error == nil ? [self.values copy] : nil;
+
+    _finished = YES;
+
+    // break the cycles between the task and the blocks in flight
+    self.block = nil;
+    self.completion = nil;
+    self.values = nil;
+
+    dispatch_async(self.queue, ^{
+        completion(values, error);
+    });
+}
+
+@end
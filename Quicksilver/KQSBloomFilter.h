@@ -0,0 +1,105 @@
+//
+//  KQSBloomFilter.h
+//  Quicksilver
+//
+//  Created by William Towe on 10/19/26.
+//  Copyright © 2021 Kosoku Interactive, LLC. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ KQSBloomFilter is a compact, probabilistic set of objects. If containsObject: returns NO the object was definitely never added, if it returns YES the object was probably added, with a false positive rate close to falsePositiveRate as long as no more than capacity objects are added. Use it as a cheap negative test before calling KQS_find: or KQS_any: on very large collections.
+
+ Objects are hashed using their `hash` method, so objects that are equal according to `isEqual:` are treated as the same member, exactly like NSSet.
+ */
+@interface KQSBloomFilter : NSObject <NSCopying>
+
+/**
+ The number of objects the receiver was sized for.
+ */
+@property (readonly,assign,nonatomic) NSUInteger capacity;
+/**
+ The false positive rate the receiver was sized for.
+ */
+@property (readonly,assign,nonatomic) double falsePositiveRate;
+/**
+ The number of bits in the receiver.
+ */
+@property (readonly,assign,nonatomic) NSUInteger numberOfBits;
+/**
+ The number of bits set for each object.
+ */
+@property (readonly,assign,nonatomic) NSUInteger numberOfHashFunctions;
+
+/**
+ Creates and returns a filter containing the objects in *array*, sized for `array.count` objects. If *concurrent* is YES, the objects are hashed on multiple threads, the result is identical either way.
+
+ @param array The array of objects to add
+ @param falsePositiveRate The desired false positive rate, between 0 and 1 exclusive
+ @param concurrent Whether to add the objects concurrently
+ @return The new filter
+ @exception NSException Thrown if array is nil or falsePositiveRate is out of range
+ */
++ (instancetype)bloomFilterWithArray:(NSArray *)array falsePositiveRate:(double)falsePositiveRate concurrent:(BOOL)concurrent;
+/**
+ Creates and returns a filter containing *objects*, sized for *capacity* objects. The objects are hashed in a single pass as they are enumerated, so a set or a dictionary's objectEnumerator can be added without first copying it into an array.
+
+ @param objects The objects to add
+ @param capacity The expected number of objects
+ @param falsePositiveRate The desired false positive rate, between 0 and 1 exclusive
+ @return The new filter
+ @exception NSException Thrown if objects is nil or falsePositiveRate is out of range
+ */
++ (instancetype)bloomFilterWithObjects:(id<NSFastEnumeration>)objects capacity:(NSUInteger)capacity falsePositiveRate:(double)falsePositiveRate;
+
+/**
+ Creates and returns an empty filter sized to hold *capacity* objects with the desired false positive rate.
+
+ @param capacity The expected number of objects
+ @param falsePositiveRate The desired false positive rate, between 0 and 1 exclusive
+ @return The initialized filter
+ @exception NSException Thrown if falsePositiveRate is out of range
+ */
+- (instancetype)initWithCapacity:(NSUInteger)capacity falsePositiveRate:(double)falsePositiveRate NS_DESIGNATED_INITIALIZER;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/**
+ Add *object* to the receiver.
+
+ @param object The object to add
+ @exception NSException Thrown if object is nil
+ */
+- (void)addObject:(id)object;
+/**
+ Returns NO if *object* was definitely not added to the receiver, otherwise YES.
+
+ @param object The object to test
+ @return Whether the object may have been added
+ */
+- (BOOL)containsObject:(id)object;
+/**
+ Add all the objects from *bloomFilter* to the receiver. Afterwards the receiver contains every object that was added to either filter.
+
+ @param bloomFilter The filter to merge, which must have been created with the same capacity and false positive rate
+ @exception NSException Thrown if bloomFilter is nil or has a different number of bits or hash functions
+ */
+- (void)unionBloomFilter:(KQSBloomFilter *)bloomFilter;
+
+@end
+
+NS_ASSUME_NONNULL_END
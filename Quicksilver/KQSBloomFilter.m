@@ -0,0 +1,167 @@
+//
+//  KQSBloomFilter.m
+//  Quicksilver
+//
+//  Created by William Towe on 10/19/26.
+//  Copyright © 2021 Kosoku Interactive, LLC. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#import "KQSBloomFilter.h"
+
+#include <math.h>
+
+// below this many objects per chunk a concurrent build is not worth the overhead
+static NSUInteger const kKQSBloomFilterConcurrentChunkSize = 16384;
+
+static inline uint64_t KQSBloomFilterMix(uint64_t value) {
+    value += 0x9E3779B97F4A7C15ULL;
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+
+    return value ^ (value >> 31);
+}
+// sets (or tests, if test is YES) the k bits of object using double hashing, bit i is h1 + i * h2
+static inline BOOL KQSBloomFilterApply(uint64_t *words, NSUInteger numberOfBits, NSUInteger numberOfHashFunctions, id object, BOOL test, BOOL atomic) {
+    uint64_t first = KQSBloomFilterMix((uint64_t)[object hash]);
+    uint64_t second = KQSBloomFilterMix(first ^ 0x5BD1E9955BD1E995ULL) | 1;
+
+    for (NSUInteger i=0; i<numberOfHashFunctions; i++) {
+        uint64_t bit = (first + i * second) % numberOfBits;
+        uint64_t mask = 1ULL << (bit & 63);
+
+        if (test) {
+            if ((words[bit >> 6] & mask) == 0) {
+                return NO;
+            }
+        }
+        else if (atomic) {
+            __atomic_fetch_or(&words[bit >> 6], mask, __ATOMIC_RELAXED);
+        }
+        else {
+            words[bit >> 6] |= mask;
+        }
+    }
+    return YES;
+}
+
+@interface KQSBloomFilter () {
+    uint64_t *_words;
+}
+@property (readwrite,assign,nonatomic) NSUInteger capacity;
+@property (readwrite,assign,nonatomic) double falsePositiveRate;
+@property (readwrite,assign,nonatomic) NSUInteger numberOfBits;
+@property (readwrite,assign,nonatomic) NSUInteger numberOfHashFunctions;
+@end
+
+@implementation KQSBloomFilter
+
+- (void)dealloc {
+    free(_words);
+}
+
+- (id)copyWithZone:(NSZone *)zone {
+    KQSBloomFilter *retval = [[[self class] alloc] initWithCapacity:self.capacity falsePositiveRate:self.falsePositiveRate];
+
+    memcpy(retval->_words, _words, self.numberOfBits / 8);
+
+    return retval;
+}
+
+- (instancetype)initWithCapacity:(NSUInteger)capacity falsePositiveRate:(double)falsePositiveRate {
+    NSParameterAssert(falsePositiveRate > 0.0 && falsePositiveRate < 1.0);
+
+    if (!(self = [super init]))
+        return nil;
+
+    _capacity = capacity;
+    _falsePositiveRate = falsePositiveRate;
+
+    double expected = (double)MAX(capacity, 1);
+    NSUInteger numberOfBits = (NSUInteger)ceil(-expected * log(falsePositiveRate) / (M_LN2 * M_LN2));
+
+    // round up to whole 64-bit words
+    _numberOfBits = MAX((numberOfBits + 63) / 64, 1) * 64;
+    _numberOfHashFunctions = MAX((NSUInteger)llround((double)_numberOfBits / expected * M_LN2), 1);
+    _words = calloc(_numberOfBits / 64, sizeof(uint64_t));
+
+    return self;
+}
+
++ (instancetype)bloomFilterWithArray:(NSArray *)array falsePositiveRate:(double)falsePositiveRate concurrent:(BOOL)concurrent {
+    NSParameterAssert(array);
+
+    NSUInteger count = array.count;
+
+    if (!concurrent ||
+        count < kKQSBloomFilterConcurrentChunkSize * 2) {
+
+        return [self bloomFilterWithObjects:array capacity:count falsePositiveRate:falsePositiveRate];
+    }
+
+    KQSBloomFilter *retval = [[self alloc] initWithCapacity:count falsePositiveRate:falsePositiveRate];
+    uint64_t *words = retval->_words;
+    NSUInteger numberOfBits = retval.numberOfBits, numberOfHashFunctions = retval.numberOfHashFunctions;
+
+    // setting bits is an atomic OR, which is order independent, so the result matches the serial build exactly
+    dispatch_apply((count + kKQSBloomFilterConcurrentChunkSize - 1) / kKQSBloomFilterConcurrentChunkSize, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t chunk) {
+        NSUInteger end = MIN(count, (chunk + 1) * kKQSBloomFilterConcurrentChunkSize);
+
+        for (NSUInteger i=chunk * kKQSBloomFilterConcurrentChunkSize; i<end; i++) {
+            KQSBloomFilterApply(words, numberOfBits, numberOfHashFunctions, [array objectAtIndex:i], NO, YES);
+        }
+    });
+
+    return retval;
+}
++ (instancetype)bloomFilterWithObjects:(id<NSFastEnumeration>)objects capacity:(NSUInteger)capacity falsePositiveRate:(double)falsePositiveRate {
+    NSParameterAssert(objects);
+
+    KQSBloomFilter *retval = [[self alloc] initWithCapacity:capacity falsePositiveRate:falsePositiveRate];
+    uint64_t *words = retval->_words;
+    NSUInteger numberOfBits = retval.numberOfBits, numberOfHashFunctions = retval.numberOfHashFunctions;
+
+    for (id object in objects) {
+        KQSBloomFilterApply(words, numberOfBits, numberOfHashFunctions, object, NO, NO);
+    }
+
+    return retval;
+}
+
+- (void)addObject:(id)object {
+    NSParameterAssert(object);
+
+    KQSBloomFilterApply(_words, self.numberOfBits, self.numberOfHashFunctions, object, NO, NO);
+}
+- (BOOL)containsObject:(id)object {
+    if (object == nil) {
+        return NO;
+    }
+    return KQSBloomFilterApply(_words, self.numberOfBits, self.numberOfHashFunctions, object, YES, NO);
+}
+- (void)unionBloomFilter:(KQSBloomFilter *)bloomFilter {
+    NSParameterAssert(bloomFilter);
+
+    // checked even when assertions are disabled, merging words of a different size would read out of bounds
+    if (bloomFilter.numberOfBits != self.numberOfBits ||
+        bloomFilter.numberOfHashFunctions != self.numberOfHashFunctions) {
+
+        [NSException raise:NSInvalidArgumentException format:@"%@: %@ bits and %@ hash functions do not match %@ bits and %@ hash functions",NSStringFromSelector(_cmd),@(bloomFilter.numberOfBits),@(bloomFilter.numberOfHashFunctions),@(self.numberOfBits),@(self.numberOfHashFunctions)];
+    }
+
+    for (NSUInteger i=0, count=self.numberOfBits / 64; i<count; i++) {
+        _words[i] |= bloomFilter->_words[i];
+    }
+}
+
+@end
@@ -0,0 +1,626 @@
+//
+//  KQSCpp.h
+//  Quicksilver
+//
+//  Created by William Towe on 10/19/26.
+//  Copyright © 2021 Kosoku Interactive, LLC. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+/**
+ Header only Objective-C++ companions to the KQS collection operators. Each function takes any callable (usually a lambda) as a template argument instead of an Objective-C block, so the compiler can inline it into the enumeration loop and no block is copied to the heap.
+
+ The leading template arguments give the type each element is passed to the callable as, defaulting to `id`. Object pointer types are cast without checking, exactly like the lightweight generics on the categories, and arithmetic types are unboxed from NSNumber. For example:
+
+    NSArray<NSString *> *names = kqs::filter<NSString *>(array, [](NSString *name, NSInteger index){ return name.length > 3; });
+    double total = kqs::reduce<double>(numbers, 0.0, [](double sum, double value, NSInteger index){ return sum + value; });
+
+ Callables mirror their block counterparts; NSArray and NSOrderedSet pass (object, index), NSSet passes (object) and NSDictionary passes (key, value). Receivers must be statically typed, passing an `id` is ambiguous.
+
+ This header is empty unless compiled as Objective-C++.
+ */
+
+#if defined(__cplusplus) && defined(__OBJC__)
+
+#import <Foundation/Foundation.h>
+
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace kqs {
+
+/**
+ Converts an element of a collection to T. The default casts object pointers, the specialization below unboxes NSNumber to arithmetic types. Specialize to support other element representations.
+ */
+template<typename T, typename Enable = void>
+struct element_traits {
+    static inline T get(id object) {
+        return (T)object;
+    }
+};
+
+template<typename T>
+struct element_traits<T, typename std::enable_if<std::is_arithmetic<T>::value>::type> {
+    static inline T get(id object) {
+        NSNumber *number = (NSNumber *)object;
+
+        if (std::is_same<T, bool>::value) {
+            return (T)number.boolValue;
+        }
+        else if (std::is_floating_point<T>::value) {
+            return (T)number.doubleValue;
+        }
+        else if (std::is_signed<T>::value) {
+            return (T)number.longLongValue;
+        }
+        else {
+            return (T)number.unsignedLongLongValue;
+        }
+    }
+};
+
+namespace detail {
+
+// invokes f(object, index) for each object in order, stopping as soon as f returns false
+template<typename Collection, typename F>
+inline void enumerate(Collection collection, F &&f) {
+    NSInteger index = 0;
+
+    for (id object in collection) {
+        if (!f(object, index++)) {
+            break;
+        }
+    }
+}
+// invokes f(key, value) for each pair, stopping as soon as f returns false, the pairs are fetched in one call rather than a lookup per key
+template<typename F>
+inline void enumerate_pairs(NSDictionary *dictionary, F &&f) {
+    NSUInteger count = dictionary.count;
+
+    if (count == 0) {
+        return;
+    }
+
+    std::vector<__unsafe_unretained id> keys(count), values(count);
+
+    [dictionary getObjects:values.data() andKeys:keys.data() count:count];
+
+    for (NSUInteger i=0; i<count; i++) {
+        if (!f(keys[i], values[i])) {
+            break;
+        }
+    }
+}
+
+} // namespace detail
+
+#pragma mark NSArray
+
+/**
+ Invokes f for each object in array, see [NSArray KQS_each:].
+ */
+template<typename T = id, typename F>
+inline void each(NSArray *array, F &&f) {
+    detail::enumerate(array, [&](id object, NSInteger index) {
+        f(element_traits<T>::get(object), index);
+        return true;
+    });
+}
+/**
+ Returns the objects in array for which f returns true, see [NSArray KQS_filter:].
+ */
+template<typename T = id, typename F>
+inline NSArray *filter(NSArray *array, F &&f) {
+    NSMutableArray *retval = [[NSMutableArray alloc] init];
+
+    detail::enumerate(array, [&](id object, NSInteger index) {
+        if (f(element_traits<T>::get(object), index)) {
+            [retval addObject:object];
+        }
+        return true;
+    });
+
+    return [retval copy];
+}
+/**
+ Returns the objects in array for which f returns false, see [NSArray KQS_reject:].
+ */
+template<typename T = id, typename F>
+inline NSArray *reject(NSArray *array, F &&f) {
+    return filter<T>(array, [&](T object, NSInteger index) {
+        return !f(object, index);
+    });
+}
+/**
+ Returns the first object in array for which f returns true or nil, see [NSArray KQS_find:].
+ */
+template<typename T = id, typename F>
+inline id find(NSArray *array, F &&f) {
+    id retval = nil;
+
+    detail::enumerate(array, [&](id object, NSInteger index) {
+        if (f(element_traits<T>::get(object), index)) {
+            retval = object;
+            return false;
+        }
+        return true;
+    });
+
+    return retval;
+}
+/**
+ Returns the array of values returned by f, with [NSNull null] substituted for nil, see [NSArray KQS_map:].
+ */
+template<typename T = id, typename F>
+inline NSArray *map(NSArray *array, F &&f) {
+    NSMutableArray *retval = [[NSMutableArray alloc] initWithCapacity:array.count];
+
+    detail::enumerate(array, [&](id object, NSInteger index) {
+        id value = f(element_traits<T>::get(object), index);
+
+        [retval addObject:value ?: [NSNull null]];
+        return true;
+    });
+
+    return [retval copy];
+}
+/**
+ Returns a vector of the values returned by f, which may be any type, without boxing them.
+ */
+template<typename T = id, typename F>
+inline auto map_vector(NSArray *array, F &&f) -> std::vector<typename std::decay<decltype(f(std::declval<T>(), NSInteger()))>::type> {
+    std::vector<typename std::decay<decltype(f(std::declval<T>(), NSInteger()))>::type> retval;
+
+    retval.reserve(array.count);
+
+    detail::enumerate(array, [&](id object, NSInteger index) {
+        retval.push_back(f(element_traits<T>::get(object), index));
+        return true;
+    });
+
+    return retval;
+}
+/**
+ Returns the result of folding f over array starting with start, see [NSArray KQS_reduceWithStart:block:]. The accumulator may be any type, so scalar reductions are not boxed.
+ */
+template<typename T = id, typename S, typename F>
+inline S reduce(NSArray *array, S start, F &&f) {
+    S retval = std::move(start);
+
+    detail::enumerate(array, [&](id object, NSInteger index) {
+        retval = f(std::move(retval), element_traits<T>::get(object), index);
+        return true;
+    });
+
+    return retval;
+}
+/**
+ Returns whether f returns true for any object in array, see [NSArray KQS_any:].
+ */
+template<typename T = id, typename F>
+inline bool any(NSArray *array, F &&f) {
+    return find<T>(array, std::forward<F>(f)) != nil;
+}
+/**
+ Returns whether f returns true for every object in array, see [NSArray KQS_all:].
+ */
+template<typename T = id, typename F>
+inline bool all(NSArray *array, F &&f) {
+    bool retval = true;
+
+    detail::enumerate(array, [&](id object, NSInteger index) {
+        retval = f(element_traits<T>::get(object), index);
+        return retval;
+    });
+
+    return retval;
+}
+/**
+ Returns whether f returns false for every object in array, see [NSArray KQS_none:].
+ */
+template<typename T = id, typename F>
+inline bool none(NSArray *array, F &&f) {
+    return !any<T>(array, std::forward<F>(f));
+}
+
+#pragma mark NSOrderedSet
+
+/**
+ Invokes f for each object in orderedSet, see [NSOrderedSet KQS_each:].
+ */
+template<typename T = id, typename F>
+inline void each(NSOrderedSet *orderedSet, F &&f) {
+    detail::enumerate(orderedSet, [&](id object, NSInteger index) {
+        f(element_traits<T>::get(object), index);
+        return true;
+    });
+}
+/**
+ Returns the objects in orderedSet for which f returns true, see [NSOrderedSet KQS_filter:].
+ */
+template<typename T = id, typename F>
+inline NSOrderedSet *filter(NSOrderedSet *orderedSet, F &&f) {
+    NSMutableOrderedSet *retval = [[NSMutableOrderedSet alloc] init];
+
+    detail::enumerate(orderedSet, [&](id object, NSInteger index) {
+        if (f(element_traits<T>::get(object), index)) {
+            [retval addObject:object];
+        }
+        return true;
+    });
+
+    return [retval copy];
+}
+/**
+ Returns the objects in orderedSet for which f returns false, see [NSOrderedSet KQS_reject:].
+ */
+template<typename T = id, typename F>
+inline NSOrderedSet *reject(NSOrderedSet *orderedSet, F &&f) {
+    return filter<T>(orderedSet, [&](T object, NSInteger index) {
+        return !f(object, index);
+    });
+}
+/**
+ Returns the first object in orderedSet for which f returns true or nil, see [NSOrderedSet KQS_find:].
+ */
+template<typename T = id, typename F>
+inline id find(NSOrderedSet *orderedSet, F &&f) {
+    id retval = nil;
+
+    detail::enumerate(orderedSet, [&](id object, NSInteger index) {
+        if (f(element_traits<T>::get(object), index)) {
+            retval = object;
+            return false;
+        }
+        return true;
+    });
+
+    return retval;
+}
+/**
+ Returns the ordered set of values returned by f, with [NSNull null] substituted for nil, see [NSOrderedSet KQS_map:].
+ */
+template<typename T = id, typename F>
+inline NSOrderedSet *map(NSOrderedSet *orderedSet, F &&f) {
+    NSMutableOrderedSet *retval = [[NSMutableOrderedSet alloc] initWithCapacity:orderedSet.count];
+
+    detail::enumerate(orderedSet, [&](id object, NSInteger index) {
+        id value = f(element_traits<T>::get(object), index);
+
+        [retval addObject:value ?: [NSNull null]];
+        return true;
+    });
+
+    return [retval copy];
+}
+/**
+ Returns a vector of the values returned by f, which may be any type, without boxing them.
+ */
+template<typename T = id, typename F>
+inline auto map_vector(NSOrderedSet *orderedSet, F &&f) -> std::vector<typename std::decay<decltype(f(std::declval<T>(), NSInteger()))>::type> {
+    std::vector<typename std::decay<decltype(f(std::declval<T>(), NSInteger()))>::type> retval;
+
+    retval.reserve(orderedSet.count);
+
+    detail::enumerate(orderedSet, [&](id object, NSInteger index) {
+        retval.push_back(f(element_traits<T>::get(object), index));
+        return true;
+    });
+
+    return retval;
+}
+/**
+ Returns the result of folding f over orderedSet starting with start, see [NSOrderedSet KQS_reduceWithStart:block:].
+ */
+template<typename T = id, typename S, typename F>
+inline S reduce(NSOrderedSet *orderedSet, S start, F &&f) {
+    S retval = std::move(start);
+
+    detail::enumerate(orderedSet, [&](id object, NSInteger index) {
+        retval = f(std::move(retval), element_traits<T>::get(object), index);
+        return true;
+    });
+
+    return retval;
+}
+/**
+ Returns whether f returns true for any object in orderedSet, see [NSOrderedSet KQS_any:].
+ */
+template<typename T = id, typename F>
+inline bool any(NSOrderedSet *orderedSet, F &&f) {
+    return find<T>(orderedSet, std::forward<F>(f)) != nil;
+}
+/**
+ Returns whether f returns true for every object in orderedSet, see [NSOrderedSet KQS_all:].
+ */
+template<typename T = id, typename F>
+inline bool all(NSOrderedSet *orderedSet, F &&f) {
+    bool retval = true;
+
+    detail::enumerate(orderedSet, [&](id object, NSInteger index) {
+        retval = f(element_traits<T>::get(object), index);
+        return retval;
+    });
+
+    return retval;
+}
+/**
+ Returns whether f returns false for every object in orderedSet, see [NSOrderedSet KQS_none:].
+ */
+template<typename T = id, typename F>
+inline bool none(NSOrderedSet *orderedSet, F &&f) {
+    return !any<T>(orderedSet, std::forward<F>(f));
+}
+
+#pragma mark NSSet
+
+/**
+ Invokes f for each object in set, see [NSSet KQS_each:].
+ */
+template<typename T = id, typename F>
+inline void each(NSSet *set, F &&f) {
+    detail::enumerate(set, [&](id object, NSInteger index) {
+        f(element_traits<T>::get(object));
+        return true;
+    });
+}
+/**
+ Returns the objects in set for which f returns true, see [NSSet KQS_filter:].
+ */
+template<typename T = id, typename F>
+inline NSSet *filter(NSSet *set, F &&f) {
+    NSMutableSet *retval = [[NSMutableSet alloc] init];
+
+    detail::enumerate(set, [&](id object, NSInteger index) {
+        if (f(element_traits<T>::get(object))) {
+            [retval addObject:object];
+        }
+        return true;
+    });
+
+    return [retval copy];
+}
+/**
+ Returns the objects in set for which f returns false, see [NSSet KQS_reject:].
+ */
+template<typename T = id, typename F>
+inline NSSet *reject(NSSet *set, F &&f) {
+    return filter<T>(set, [&](T object) {
+        return !f(object);
+    });
+}
+/**
+ Returns any object in set for which f returns true or nil, see [NSSet KQS_find:].
+ */
+template<typename T = id, typename F>
+inline id find(NSSet *set, F &&f) {
+    id retval = nil;
+
+    detail::enumerate(set, [&](id object, NSInteger index) {
+        if (f(element_traits<T>::get(object))) {
+            retval = object;
+            return false;
+        }
+        return true;
+    });
+
+    return retval;
+}
+/**
+ Returns the set of values returned by f, with [NSNull null] substituted for nil, see [NSSet KQS_map:].
+ */
+template<typename T = id, typename F>
+inline NSSet *map(NSSet *set, F &&f) {
+    NSMutableSet *retval = [[NSMutableSet alloc] initWithCapacity:set.count];
+
+    detail::enumerate(set, [&](id object, NSInteger index) {
+        id value = f(element_traits<T>::get(object));
+
+        [retval addObject:value ?: [NSNull null]];
+        return true;
+    });
+
+    return [retval copy];
+}
+/**
+ Returns a vector of the values returned by f, which may be any type, without boxing them. The order is the enumeration order of set.
+ */
+template<typename T = id, typename F>
+inline auto map_vector(NSSet *set, F &&f) -> std::vector<typename std::decay<decltype(f(std::declval<T>()))>::type> {
+    std::vector<typename std::decay<decltype(f(std::declval<T>()))>::type> retval;
+
+    retval.reserve(set.count);
+
+    detail::enumerate(set, [&](id object, NSInteger index) {
+        retval.push_back(f(element_traits<T>::get(object)));
+        return true;
+    });
+
+    return retval;
+}
+/**
+ Returns the result of folding f over set starting with start, see [NSSet KQS_reduceWithStart:block:].
+ */
+template<typename T = id, typename S, typename F>
+inline S reduce(NSSet *set, S start, F &&f) {
+    S retval = std::move(start);
+
+    detail::enumerate(set, [&](id object, NSInteger index) {
+        retval = f(std::move(retval), element_traits<T>::get(object));
+        return true;
+    });
+
+    return retval;
+}
+/**
+ Returns whether f returns true for any object in set, see [NSSet KQS_any:].
+ */
+template<typename T = id, typename F>
+inline bool any(NSSet *set, F &&f) {
+    return find<T>(set, std::forward<F>(f)) != nil;
+}
+/**
+ Returns whether f returns true for every object in set, see [NSSet KQS_all:].
+ */
+template<typename T = id, typename F>
+inline bool all(NSSet *set, F &&f) {
+    bool retval = true;
+
+    detail::enumerate(set, [&](id object, NSInteger index) {
+        retval = f(element_traits<T>::get(object));
+        return retval;
+    });
+
+    return retval;
+}
+/**
+ Returns whether f returns false for every object in set, see [NSSet KQS_none:].
+ */
+template<typename T = id, typename F>
+inline bool none(NSSet *set, F &&f) {
+    return !any<T>(set, std::forward<F>(f));
+}
+
+#pragma mark NSDictionary
+
+/**
+ Invokes f for each key and value in dictionary, see [NSDictionary KQS_each:].
+ */
+template<typename K = id, typename V = id, typename F>
+inline void each(NSDictionary *dictionary, F &&f) {
+    detail::enumerate_pairs(dictionary, [&](id key, id value) {
+        f(element_traits<K>::get(key), element_traits<V>::get(value));
+        return true;
+    });
+}
+/**
+ Returns the keys and values in dictionary for which f returns true, see [NSDictionary KQS_filter:].
+ */
+template<typename K = id, typename V = id, typename F>
+inline NSDictionary *filter(NSDictionary *dictionary, F &&f) {
+    NSMutableDictionary *retval = [[NSMutableDictionary alloc] init];
+
+    detail::enumerate_pairs(dictionary, [&](id key, id value) {
+        if (f(element_traits<K>::get(key), element_traits<V>::get(value))) {
+            [retval setObject:value forKey:key];
+        }
+        return true;
+    });
+
+    return [retval copy];
+}
+/**
+ Returns the keys and values in dictionary for which f returns false, see [NSDictionary KQS_reject:].
+ */
+template<typename K = id, typename V = id, typename F>
+inline NSDictionary *reject(NSDictionary *dictionary, F &&f) {
+    return filter<K, V>(dictionary, [&](K key, V value) {
+        return !f(key, value);
+    });
+}
+/**
+ Returns the value of any pair in dictionary for which f returns true or nil, see [NSDictionary KQS_find:].
+ */
+template<typename K = id, typename V = id, typename F>
+inline id find(NSDictionary *dictionary, F &&f) {
+    id retval = nil;
+
+    detail::enumerate_pairs(dictionary, [&](id key, id value) {
+        if (f(element_traits<K>::get(key), element_traits<V>::get(value))) {
+            retval = value;
+            return false;
+        }
+        return true;
+    });
+
+    return retval;
+}
+/**
+ Returns a dictionary with the same keys and the values returned by f, with [NSNull null] substituted for nil, see [NSDictionary KQS_map:].
+ */
+template<typename K = id, typename V = id, typename F>
+inline NSDictionary *map(NSDictionary *dictionary, F &&f) {
+    NSMutableDictionary *retval = [[NSMutableDictionary alloc] initWithCapacity:dictionary.count];
+
+    detail::enumerate_pairs(dictionary, [&](id key, id value) {
+        id mapped = f(element_traits<K>::get(key), element_traits<V>::get(value));
+
+        [retval setObject:mapped ?: [NSNull null] forKey:key];
+        return true;
+    });
+
+    return [retval copy];
+}
+/**
+ Returns a vector of the values returned by f, which may be any type, without boxing them. The order is the enumeration order of dictionary.
+ */
+template<typename K = id, typename V = id, typename F>
+inline auto map_vector(NSDictionary *dictionary, F &&f) -> std::vector<typename std::decay<decltype(f(std::declval<K>(), std::declval<V>()))>::type> {
+    std::vector<typename std::decay<decltype(f(std::declval<K>(), std::declval<V>()))>::type> retval;
+
+    retval.reserve(dictionary.count);
+
+    detail::enumerate_pairs(dictionary, [&](id key, id value) {
+        retval.push_back(f(element_traits<K>::get(key), element_traits<V>::get(value)));
+        return true;
+    });
+
+    return retval;
+}
+/**
+ Returns the result of folding f over the keys and values of dictionary starting with start, see [NSDictionary KQS_reduceWithStart:block:].
+ */
+template<typename K = id, typename V = id, typename S, typename F>
+inline S reduce(NSDictionary *dictionary, S start, F &&f) {
+    S retval = std::move(start);
+
+    detail::enumerate_pairs(dictionary, [&](id key, id value) {
+        retval = f(std::move(retval), element_traits<K>::get(key), element_traits<V>::get(value));
+        return true;
+    });
+
+    return retval;
+}
+/**
+ Returns whether f returns true for any pair in dictionary, see [NSDictionary KQS_any:].
+ */
+template<typename K = id, typename V = id, typename F>
+inline bool any(NSDictionary *dictionary, F &&f) {
+    return find<K, V>(dictionary, std::forward<F>(f)) != nil;
+}
+/**
+ Returns whether f returns true for every pair in dictionary, see [NSDictionary KQS_all:].
+ */
+template<typename K = id, typename V = id, typename F>
+inline bool all(NSDictionary *dictionary, F &&f) {
+    bool retval = true;
+
+    detail::enumerate_pairs(dictionary, [&](id key, id value) {
+        retval = f(element_traits<K>::get(key), element_traits<V>::get(value));
+        return retval;
+    });
+
+    return retval;
+}
+/**
+ Returns whether f returns false for every pair in dictionary, see [NSDictionary KQS_none:].
+ */
+template<typename K = id, typename V = id, typename F>
+inline bool none(NSDictionary *dictionary, F &&f) {
+    return !any<K, V>(dictionary, std::forward<F>(f));
+}
+
+} // namespace kqs
+
+#endif
@@ -0,0 +1,97 @@
+//
+//  KQSHyperLogLog.h
+//  Quicksilver
+//
+//  Created by William Towe on 10/19/26.
+//  Copyright © 2021 Kosoku Interactive, LLC. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ The default precision, which uses 16KB of registers and has a standard error of roughly 0.8%.
+ */
+FOUNDATION_EXPORT NSUInteger const KQSHyperLogLogDefaultPrecision;
+
+/**
+ KQSHyperLogLog estimates the number of distinct objects added to it using a fixed amount of memory (2^precision bytes), regardless of how many objects are added. Sketches with the same precision can be merged, so large inputs can be counted in pieces.
+
+ Objects are hashed using their `hash` method, so objects that are equal according to `isEqual:` are counted once, exactly like NSSet.
+ */
+@interface KQSHyperLogLog : NSObject <NSCopying>
+
+/**
+ The precision of the receiver, the number of registers is 2^precision.
+ */
+@property (readonly,assign,nonatomic) NSUInteger precision;
+/**
+ The estimated number of distinct objects added to the receiver.
+ */
+@property (readonly,assign,nonatomic) NSUInteger count;
+
+/**
+ Creates and returns a sketch containing the objects in *array*. If *concurrent* is YES, the array is split into chunks which are counted on multiple threads and merged, the result is identical either way.
+
+ @param array The array of objects to add
+ @param precision The precision, between 4 and 18 inclusive
+ @param concurrent Whether to add the objects concurrently
+ @return The new sketch
+ @exception NSException Thrown if array is nil or precision is out of range
+ */
++ (instancetype)hyperLogLogWithArray:(NSArray *)array precision:(NSUInteger)precision concurrent:(BOOL)concurrent;
+/**
+ Creates and returns a sketch containing *objects*. The objects are hashed in a single pass as they are enumerated, so a set or a dictionary's objectEnumerator can be counted without first copying it into an array.
+
+ @param objects The objects to add
+ @param precision The precision, between 4 and 18 inclusive
+ @return The new sketch
+ @exception NSException Thrown if objects is nil or precision is out of range
+ */
++ (instancetype)hyperLogLogWithObjects:(id<NSFastEnumeration>)objects precision:(NSUInteger)precision;
+
+/**
+ Creates and returns an empty sketch with KQSHyperLogLogDefaultPrecision.
+
+ @return The initialized sketch
+ */
+- (instancetype)init;
+/**
+ Creates and returns an empty sketch with the provided precision. Higher precision uses more memory and gives a more accurate count, the standard error is roughly 1.04 / sqrt(2^precision).
+
+ @param precision The precision, between 4 and 18 inclusive
+ @return The initialized sketch
+ @exception NSException Thrown if precision is out of range
+ */
+- (instancetype)initWithPrecision:(NSUInteger)precision NS_DESIGNATED_INITIALIZER;
+
+/**
+ Add *object* to the receiver.
+
+ @param object The object to add
+ @exception NSException Thrown if object is nil
+ */
+- (void)addObject:(id)object;
+/**
+ Merge *hyperLogLog* into the receiver. Afterwards the receiver estimates the number of distinct objects added to either sketch.
+
+ @param hyperLogLog The sketch to merge
+ @exception NSException Thrown if hyperLogLog is nil or has a different precision
+ */
+- (void)unionHyperLogLog:(KQSHyperLogLog *)hyperLogLog;
+
+@end
+
+NS_ASSUME_NONNULL_END
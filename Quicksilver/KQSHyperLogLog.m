@@ -0,0 +1,195 @@
+//
+//  KQSHyperLogLog.m
+//  Quicksilver
+//
+//  Created by William Towe on 10/19/26.
+//  Copyright © 2021 Kosoku Interactive, LLC. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#import "KQSHyperLogLog.h"
+
+#include <math.h>
+
+NSUInteger const KQSHyperLogLogDefaultPrecision = 14;
+
+static NSUInteger const kKQSHyperLogLogMinimumPrecision = 4;
+static NSUInteger const kKQSHyperLogLogMaximumPrecision = 18;
+// below this many objects per stripe a concurrent build is not worth the overhead
+static NSUInteger const kKQSHyperLogLogConcurrentChunkSize = 16384;
+
+// splitmix64 finalizer, spreads the often poorly distributed values returned by -hash over all 64 bits
+static inline uint64_t KQSHyperLogLogHash(id object) {
+    uint64_t retval = (uint64_t)[object hash] + 0x9E3779B97F4A7C15ULL;
+
+    retval = (retval ^ (retval >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    retval = (retval ^ (retval >> 27)) * 0x94D049BB133111EBULL;
+
+    return retval ^ (retval >> 31);
+}
+static inline void KQSHyperLogLogAdd(uint8_t *registers, NSUInteger precision, id object) {
+    uint64_t hash = KQSHyperLogLogHash(object);
+    uint64_t index = hash >> (64 - precision);
+    // the guard bit bounds the rank when the remaining bits are all zero
+    uint8_t rank = (uint8_t)__builtin_clzll((hash << precision) | (1ULL << (precision - 1))) + 1;
+
+    if (rank > registers[index]) {
+        registers[index] = rank;
+    }
+}
+
+@interface KQSHyperLogLog () {
+    uint8_t *_registers;
+}
+@property (readwrite,assign,nonatomic) NSUInteger precision;
+@end
+
+@implementation KQSHyperLogLog
+
+- (void)dealloc {
+    free(_registers);
+}
+
+- (id)copyWithZone:(NSZone *)zone {
+    KQSHyperLogLog *retval = [[[self class] alloc] initWithPrecision:self.precision];
+
+    memcpy(retval->_registers, _registers, 1 << self.precision);
+
+    return retval;
+}
+
+- (instancetype)init {
+    return [self initWithPrecision:KQSHyperLogLogDefaultPrecision];
+}
+- (instancetype)initWithPrecision:(NSUInteger)precision {
+    NSParameterAssert(precision >= kKQSHyperLogLogMinimumPrecision && precision <= kKQSHyperLogLogMaximumPrecision);
+
+    if (!(self = [super init]))
+        return nil;
+
+    _precision = precision;
+    _registers = calloc(1 << precision, sizeof(uint8_t));
+
+    return self;
+}
+
++ (instancetype)hyperLogLogWithArray:(NSArray *)array precision:(NSUInteger)precision concurrent:(BOOL)concurrent {
+    NSParameterAssert(array);
+
+    NSUInteger count = array.count;
+
+    if (!concurrent ||
+        count < kKQSHyperLogLogConcurrentChunkSize * 2) {
+
+        return [self hyperLogLogWithObjects:array precision:precision];
+    }
+
+    KQSHyperLogLog *retval = [[self alloc] initWithPrecision:precision];
+    NSUInteger numberOfRegisters = 1 << precision;
+    // one set of registers per stripe rather than per chunk, so the scratch memory is bounded by the number of processors rather than the count
+    NSUInteger stripes = MAX(1, MIN(NSProcessInfo.processInfo.activeProcessorCount, count / kKQSHyperLogLogConcurrentChunkSize));
+    NSUInteger stripeLength = (count + stripes - 1) / stripes;
+    // each stripe adds to its own registers, merged below, so no synchronization is needed while adding
+    uint8_t *partials = calloc(stripes * numberOfRegisters, sizeof(uint8_t));
+
+    dispatch_apply(stripes, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t stripe) {
+        uint8_t *registers = partials + stripe * numberOfRegisters;
+        NSUInteger end = MIN(count, (stripe + 1) * stripeLength);
+
+        for (NSUInteger i=stripe * stripeLength; i<end; i++) {
+            KQSHyperLogLogAdd(registers, precision, [array objectAtIndex:i]);
+        }
+    });
+
+    for (NSUInteger stripe=0; stripe<stripes; stripe++) {
+        uint8_t *registers = partials + stripe * numberOfRegisters;
+
+        for (NSUInteger i=0; i<numberOfRegisters; i++) {
+            retval->_registers[i] = MAX(retval->_registers[i], registers[i]);
+        }
+    }
+
+    free(partials);
+
+    return retval;
+}
++ (instancetype)hyperLogLogWithObjects:(id<NSFastEnumeration>)objects precision:(NSUInteger)precision {
+    NSParameterAssert(objects);
+
+    KQSHyperLogLog *retval = [[self alloc] initWithPrecision:precision];
+
+    for (id object in objects) {
+        KQSHyperLogLogAdd(retval->_registers, precision, object);
+    }
+
+    return retval;
+}
+
+- (void)addObject:(id)object {
+    NSParameterAssert(object);
+
+    KQSHyperLogLogAdd(_registers, self.precision, object);
+}
+- (void)unionHyperLogLog:(KQSHyperLogLog *)hyperLogLog {
+    NSParameterAssert(hyperLogLog);
+
+    // checked even when assertions are disabled, merging registers of a different size would read out of bounds
+    if (hyperLogLog.precision != self.precision) {
+        [NSException raise:NSInvalidArgumentException format:@"%@: precision %@ does not match %@",NSStringFromSelector(_cmd),@(hyperLogLog.precision),@(self.precision)];
+    }
+
+    for (NSUInteger i=0, count=1 << self.precision; i<count; i++) {
+        _registers[i] = MAX(_registers[i], hyperLogLog->_registers[i]);
+    }
+}
+
+- (NSUInteger)count {
+    NSUInteger numberOfRegisters = 1 << self.precision, zeros = 0;
+    double m = (double)numberOfRegisters, sum = 0.0, alpha;
+
+    switch (numberOfRegisters) {
+        case 16:
+            alpha = 0.673;
+            break;
+        case 32:
+            alpha = 0.697;
+            break;
+        case 64:
+            alpha = 0.709;
+            break;
+        default:
+            alpha = 0.7213 / (1.0 + 1.079 / m);
+            break;
+    }
+
+    for (NSUInteger i=0; i<numberOfRegisters; i++) {
+        sum += ldexp(1.0, -(int)_registers[i]);
+
+        if (_registers[i] == 0) {
+            zeros++;
+        }
+    }
+
+    double retval = alpha * m * m / sum;
+
+    // linear counting is more accurate for small cardinalities, a 64-bit hash makes the large range correction unnecessary
+    if (retval <= 2.5 * m &&
+        zeros > 0) {
+
+        retval = m * log(m / (double)zeros);
+    }
+
+    return (NSUInteger)llround(retval);
+}
+
+@end
@@ -0,0 +1,112 @@
+//
+//  KQSKeyPathGetter.h
+//  Quicksilver
+//
+//  Created by William Towe on 10/19/26.
+//  Copyright © 2021 Kosoku Interactive, LLC. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ A numeric value read by KQSKeyPathGetter without boxing it.
+ */
+typedef struct {
+    double doubleValue;
+    long long integerValue;
+    /**
+     The value if largeUnsigned is YES.
+     */
+    unsigned long long unsignedIntegerValue;
+    BOOL integral;
+    /**
+     Whether the value is an unsigned integer above LLONG_MAX, which integerValue cannot hold.
+     */
+    BOOL largeUnsigned;
+} KQSKeyPathNumber;
+
+/**
+ KQSKeyPathGetter reads the value of a key path the way valueForKeyPath: does, but splits the key path once and resolves the getter IMP for each key once per class, caching a few classes per key. Repeated reads from objects of the same class call the IMP directly, without the per object KVC lookup.
+
+ Objects whose class overrides valueForKey:, collections, and key paths containing collection operators (e.g. @sum) fall back to KVC, so the results are always the same as valueForKeyPath:.
+
+ Instances are not thread safe, create one per operation.
+ */
+@interface KQSKeyPathGetter : NSObject
+
+/**
+ Creates and returns a getter for *keyPath*.
+
+ @param keyPath The key path to read
+ @return The initialized getter
+ @exception NSException Thrown if keyPath is nil
+ */
+- (instancetype)initWithKeyPath:(NSString *)keyPath NS_DESIGNATED_INITIALIZER;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/**
+ Returns the value of the receiver's key path for *object*, which is the same as `[object valueForKeyPath:keyPath]`.
+
+ @param object The object to read from
+ @return The value
+ */
+- (nullable id)valueForObject:(id)object;
+/**
+ Reads the value of the receiver's key path for *object* into *number*, without boxing it if the final getter returns a scalar. Returns NO if the value is nil or not an NSNumber.
+
+ @param number The number to fill in
+ @param object The object to read from
+ @return Whether the value is a number
+ */
+- (BOOL)getNumber:(KQSKeyPathNumber *)number forObject:(id)object;
+/**
+ Returns whether the value of the receiver's key path for *object* is equal to *value*, nil and NSNull are considered equal.
+
+ @param object The object to read from
+ @param value The value to compare to
+ @return Whether the values are equal
+ */
+- (BOOL)valueForObject:(id)object isEqual:(nullable id)value;
+
+/**
+ Returns the sum of the values of the receiver's key path for *objects* as an NSNumber, integral if every value is integral. If an integral sum does not fit in a long long, it is returned exactly as an NSDecimalNumber instead. Values that are not numbers are skipped.
+
+ @param objects The objects to read from
+ @return The sum
+ */
+- (NSNumber *)sumOfObjects:(id<NSFastEnumeration>)objects;
+/**
+ Returns the object in *objects* with the maximum or minimum value for the receiver's key path, compared numerically if every value is a number and using `compare:` otherwise. Objects whose value is nil or NSNull are skipped.
+
+ @param objects The objects to read from
+ @param maximum Whether to return the maximum or the minimum
+ @return The object or nil
+ */
+- (nullable id)extremeObjectInObjects:(id<NSFastEnumeration>)objects maximum:(BOOL)maximum;
+/**
+ Returns *objects* sorted by the values of the receiver's key path for the corresponding objects in *sources*, which reads each value once. The sort is stable and nil or NSNull values sort before all others.
+
+ @param objects The objects to sort
+ @param sources The objects to read from, which must have the same count as objects
+ @param ascending Whether to sort ascending or descending
+ @return The sorted objects
+ */
+- (NSArray *)sortObjects:(NSArray *)objects bySources:(NSArray *)sources ascending:(BOOL)ascending;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,509 @@
+//
+//  KQSKeyPathGetter.m
+//  Quicksilver
+//
+//  Created by William Towe on 10/19/26.
+//  Copyright © 2021 Kosoku Interactive, LLC. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#import "KQSKeyPathGetter.h"
+
+#import <objc/runtime.h>
+
+// the number of classes cached per key, enough for a homogeneous collection plus a few subclasses or tagged pointer classes
+#define KQS_KEY_PATH_GETTER_CACHE_SIZE 4
+// the order valueForKey: searches for a getter, get<Key>, <key>, is<Key> and _<key>
+#define KQS_KEY_PATH_GETTER_SELECTOR_COUNT 4
+
+typedef struct {
+    __unsafe_unretained Class cls;
+    SEL selector;
+    IMP imp;
+    // the return type encoding of imp, or 0 if valueForKey: must be used
+    char type;
+} KQSKeyPathGetterEntry;
+
+typedef struct {
+    KQSKeyPathGetterEntry entries[KQS_KEY_PATH_GETTER_CACHE_SIZE];
+    SEL selectors[KQS_KEY_PATH_GETTER_SELECTOR_COUNT];
+    NSUInteger nextEntry;
+} KQSKeyPathGetterComponent;
+
+static void KQSKeyPathGetterResolve(KQSKeyPathGetterEntry *entry, Class cls, const SEL *selectors) {
+    static IMP kDefaultValueForKey;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        kDefaultValueForKey = class_getMethodImplementation([NSObject class], @selector(valueForKey:));
+    });
+
+    entry->cls = cls;
+    entry->type = 0;
+
+    // collections, dictionaries and classes like NSManagedObject give valueForKey: their own meaning
+    if (class_getMethodImplementation(cls, @selector(valueForKey:)) != kDefaultValueForKey) {
+        return;
+    }
+
+    for (NSUInteger i=0; i<KQS_KEY_PATH_GETTER_SELECTOR_COUNT; i++) {
+        Method method = class_getInstanceMethod(cls, selectors[i]);
+
+        if (method == NULL ||
+            method_getNumberOfArguments(method) != 2) {
+
+            continue;
+        }
+
+        char type[16];
+
+        method_getReturnType(method, type, sizeof(type));
+
+        const char *scan = type;
+
+        // skip qualifiers like const and oneway
+        while (*scan != '\0' && strchr("rnNoORV", *scan) != NULL) {
+            scan++;
+        }
+
+        // any other return type, like a struct, is left to valueForKey:
+        if (*scan != '\0' &&
+            strchr("@#cCsSiIlLqQfdB", *scan) != NULL) {
+
+            entry->selector = selectors[i];
+            entry->imp = method_getImplementation(method);
+            entry->type = *scan;
+        }
+        return;
+    }
+}
+
+static inline const KQSKeyPathGetterEntry *KQSKeyPathGetterEntryForObject(KQSKeyPathGetterComponent *component, id object) {
+    Class cls = object_getClass(object);
+
+    for (NSUInteger i=0; i<KQS_KEY_PATH_GETTER_CACHE_SIZE; i++) {
+        if (component->entries[i].cls == cls) {
+            return &component->entries[i];
+        }
+    }
+
+    KQSKeyPathGetterEntry *retval = &component->entries[component->nextEntry++ % KQS_KEY_PATH_GETTER_CACHE_SIZE];
+
+    KQSKeyPathGetterResolve(retval, cls, component->selectors);
+
+    return retval;
+}
+
+#define KQS_KEY_PATH_GETTER_CALL(TYPE) ((TYPE(*)(id, SEL))entry->imp)(object, entry->selector)
+
+static inline id KQSKeyPathGetterValue(const KQSKeyPathGetterEntry *entry, id object, NSString *key) {
+    switch (entry->type) {
+        case '@':
+        case '#':
+            return KQS_KEY_PATH_GETTER_CALL(id);
+        case 'c':
+            return @(KQS_KEY_PATH_GETTER_CALL(char));
+        case 'C':
+            return @(KQS_KEY_PATH_GETTER_CALL(unsigned char));
+        case 's':
+            return @(KQS_KEY_PATH_GETTER_CALL(short));
+        case 'S':
+            return @(KQS_KEY_PATH_GETTER_CALL(unsigned short));
+        case 'i':
+            return @(KQS_KEY_PATH_GETTER_CALL(int));
+        case 'I':
+            return @(KQS_KEY_PATH_GETTER_CALL(unsigned int));
+        case 'l':
+            return @(KQS_KEY_PATH_GETTER_CALL(long));
+        case 'L':
+            return @(KQS_KEY_PATH_GETTER_CALL(unsigned long));
+        case 'q':
+            return @(KQS_KEY_PATH_GETTER_CALL(long long));
+        case 'Q':
+            return @(KQS_KEY_PATH_GETTER_CALL(unsigned long long));
+        case 'f':
+            return @(KQS_KEY_PATH_GETTER_CALL(float));
+        case 'd':
+            return @(KQS_KEY_PATH_GETTER_CALL(double));
+        case 'B':
+            return @(KQS_KEY_PATH_GETTER_CALL(bool));
+        default:
+            return [object valueForKey:key];
+    }
+}
+
+static inline void KQSKeyPathGetterSetInteger(KQSKeyPathNumber *number, long long value) {
+    number->integerValue = value;
+    number->unsignedIntegerValue = 0;
+    number->doubleValue = (double)value;
+    number->integral = YES;
+    number->largeUnsigned = NO;
+}
+static inline void KQSKeyPathGetterSetUnsignedInteger(KQSKeyPathNumber *number, unsigned long long value) {
+    if (value <= LLONG_MAX) {
+        KQSKeyPathGetterSetInteger(number, (long long)value);
+        return;
+    }
+
+    number->integerValue = LLONG_MAX;
+    number->unsignedIntegerValue = value;
+    number->doubleValue = (double)value;
+    number->integral = YES;
+    number->largeUnsigned = YES;
+}
+static inline void KQSKeyPathGetterSetDouble(KQSKeyPathNumber *number, double value) {
+    number->integerValue = (long long)value;
+    number->unsignedIntegerValue = 0;
+    number->doubleValue = value;
+    number->integral = NO;
+    number->largeUnsigned = NO;
+}
+// large unsigned values are above every value that fits in integerValue
+static inline NSComparisonResult KQSKeyPathGetterCompareIntegers(const KQSKeyPathNumber *first, const KQSKeyPathNumber *second) {
+    if (first->largeUnsigned ||
+        second->largeUnsigned) {
+
+        unsigned long long firstValue = first->largeUnsigned ? first->unsignedIntegerValue : 0, secondValue = second->largeUnsigned ? second->unsignedIntegerValue : 0;
+
+        return firstValue > secondValue ? NSOrderedDescending : firstValue < secondValue ? NSOrderedAscending : NSOrderedSame;
+    }
+    return first->integerValue > second->integerValue ? NSOrderedDescending : first->integerValue < second->integerValue ? NSOrderedAscending : NSOrderedSame;
+}
+static inline NSDecimalNumber *KQSKeyPathGetterDecimalNumber(const KQSKeyPathNumber *number) {
+    if (number->largeUnsigned) {
+        return [NSDecimalNumber decimalNumberWithMantissa:number->unsignedIntegerValue exponent:0 isNegative:NO];
+    }
+
+    long long value = number->integerValue;
+    // negating LLONG_MIN overflows, so the magnitude is computed in unsigned arithmetic
+    unsigned long long magnitude = value < 0 ? 0ULL - (unsigned long long)value : (unsigned long long)value;
+
+    return [NSDecimalNumber decimalNumberWithMantissa:magnitude exponent:0 isNegative:value < 0];
+}
+
+@interface KQSKeyPathGetter () {
+    KQSKeyPathGetterComponent *_components;
+}
+@property (copy,nonatomic) NSString *keyPath;
+@property (copy,nonatomic) NSArray<NSString *> *keys;
+// key paths with collection operators or empty keys are passed straight to valueForKeyPath:
+@property (assign,nonatomic) BOOL usesKeyValueCoding;
+@end
+
+@implementation KQSKeyPathGetter
+
+- (void)dealloc {
+    free(_components);
+}
+
+- (instancetype)initWithKeyPath:(NSString *)keyPath {
+    NSParameterAssert(keyPath);
+
+    if (!(self = [super init]))
+        return nil;
+
+    _keyPath = [keyPath copy];
+    _keys = [_keyPath componentsSeparatedByString:@"."];
+    _components = calloc(_keys.count, sizeof(KQSKeyPathGetterComponent));
+
+    for (NSUInteger i=0; i<_keys.count; i++) {
+        NSString *key = _keys[i];
+
+        if (key.length == 0 ||
+            [key hasPrefix:@"@"]) {
+
+            _usesKeyValueCoding = YES;
+            break;
+        }
+
+        NSString *capitalizedKey = [[key substringToIndex:1].uppercaseString stringByAppendingString:[key substringFromIndex:1]];
+
+        _components[i].selectors[0] = NSSelectorFromString([@"get" stringByAppendingString:capitalizedKey]);
+        _components[i].selectors[1] = NSSelectorFromString(key);
+        _components[i].selectors[2] = NSSelectorFromString([@"is" stringByAppendingString:capitalizedKey]);
+        _components[i].selectors[3] = NSSelectorFromString([@"_" stringByAppendingString:key]);
+    }
+
+    return self;
+}
+
+- (id)valueForObject:(id)object {
+    if (self.usesKeyValueCoding) {
+        return [object valueForKeyPath:self.keyPath];
+    }
+
+    id retval = object;
+    NSArray<NSString *> *keys = self.keys;
+
+    for (NSUInteger i=0, count=keys.count; i<count && retval != nil; i++) {
+        retval = KQSKeyPathGetterValue(KQSKeyPathGetterEntryForObject(&_components[i], retval), retval, keys[i]);
+    }
+
+    return retval;
+}
+- (BOOL)getNumber:(KQSKeyPathNumber *)number forObject:(id)object {
+    NSParameterAssert(number);
+
+    id value = nil;
+
+    if (self.usesKeyValueCoding) {
+        value = [object valueForKeyPath:self.keyPath];
+    }
+    else {
+        NSArray<NSString *> *keys = self.keys;
+        NSUInteger last = keys.count - 1;
+
+        for (NSUInteger i=0; i<last && object != nil; i++) {
+            object = KQSKeyPathGetterValue(KQSKeyPathGetterEntryForObject(&_components[i], object), object, keys[i]);
+        }
+
+        if (object == nil) {
+            return NO;
+        }
+
+        const KQSKeyPathGetterEntry *entry = KQSKeyPathGetterEntryForObject(&_components[last], object);
+
+        // scalar getters are read without boxing, which is the point of this method
+        switch (entry->type) {
+            case 'c':
+                KQSKeyPathGetterSetInteger(number, KQS_KEY_PATH_GETTER_CALL(char));
+                return YES;
+            case 'C':
+                KQSKeyPathGetterSetInteger(number, KQS_KEY_PATH_GETTER_CALL(unsigned char));
+                return YES;
+            case 's':
+                KQSKeyPathGetterSetInteger(number, KQS_KEY_PATH_GETTER_CALL(short));
+                return YES;
+            case 'S':
+                KQSKeyPathGetterSetInteger(number, KQS_KEY_PATH_GETTER_CALL(unsigned short));
+                return YES;
+            case 'i':
+                KQSKeyPathGetterSetInteger(number, KQS_KEY_PATH_GETTER_CALL(int));
+                return YES;
+            case 'I':
+                KQSKeyPathGetterSetInteger(number, KQS_KEY_PATH_GETTER_CALL(unsigned int));
+                return YES;
+            case 'l':
+                KQSKeyPathGetterSetInteger(number, KQS_KEY_PATH_GETTER_CALL(long));
+                return YES;
+            case 'L':
+                KQSKeyPathGetterSetUnsignedInteger(number, KQS_KEY_PATH_GETTER_CALL(unsigned long));
+                return YES;
+            case 'q':
+                KQSKeyPathGetterSetInteger(number, KQS_KEY_PATH_GETTER_CALL(long long));
+                return YES;
+            case 'Q':
+                KQSKeyPathGetterSetUnsignedInteger(number, KQS_KEY_PATH_GETTER_CALL(unsigned long long));
+                return YES;
+            case 'B':
+                KQSKeyPathGetterSetInteger(number, KQS_KEY_PATH_GETTER_CALL(bool));
+                return YES;
+            case 'f':
+                KQSKeyPathGetterSetDouble(number, KQS_KEY_PATH_GETTER_CALL(float));
+                return YES;
+            case 'd':
+                KQSKeyPathGetterSetDouble(number, KQS_KEY_PATH_GETTER_CALL(double));
+                return YES;
+            default:
+                value = KQSKeyPathGetterValue(entry, object, keys[last]);
+                break;
+        }
+    }
+
+    if (![value isKindOfClass:[NSNumber class]]) {
+        return NO;
+    }
+
+    NSNumber *boxed = value;
+
+    if ([boxed isKindOfClass:[NSDecimalNumber class]]) {
+        KQSKeyPathGetterSetDouble(number, boxed.doubleValue);
+    }
+    // longLongValue would wrap unsigned values above LLONG_MAX to negative ones
+    else if (strchr("LQ", boxed.objCType[0]) != NULL) {
+        KQSKeyPathGetterSetUnsignedInteger(number, boxed.unsignedLongLongValue);
+    }
+    else if (strchr("cCsSiIlqB", boxed.objCType[0]) != NULL) {
+        KQSKeyPathGetterSetInteger(number, boxed.longLongValue);
+    }
+    else {
+        KQSKeyPathGetterSetDouble(number, boxed.doubleValue);
+    }
+    return YES;
+}
+
+- (BOOL)valueForObject:(id)object isEqual:(id)value {
+    id objectValue = [self valueForObject:object];
+
+    if (objectValue == [NSNull null]) {
+        objectValue = nil;
+    }
+    if (value == [NSNull null]) {
+        value = nil;
+    }
+
+    return objectValue == value || [objectValue isEqual:value];
+}
+
+- (NSNumber *)sumOfObjects:(id<NSFastEnumeration>)objects {
+    long long integerSum = 0;
+    double doubleSum = 0.0;
+    // the exact integral sum, once it no longer fits in integerSum
+    NSDecimalNumber *decimalSum = nil;
+    BOOL integral = YES;
+    KQSKeyPathNumber number;
+
+    for (id object in objects) {
+        if (![self getNumber:&number forObject:object]) {
+            continue;
+        }
+        
+        doubleSum += number.doubleValue;
+        integral = integral && number.integral;
+        
+        if (!integral) {
+            continue;
+        }
+        
+        long long sum;
+        
+        if (decimalSum == nil &&
+            !number.largeUnsigned &&
+            !__builtin_add_overflow(integerSum, number.integerValue, &sum)) {
+            
+            integerSum = sum;
+            continue;
+        }
+        
+        if (decimalSum == nil) {
+            KQSKeyPathNumber partial;
+            
+            KQSKeyPathGetterSetInteger(&partial, integerSum);
+            
+            decimalSum = KQSKeyPathGetterDecimalNumber(&partial);
+        }
+        
+        decimalSum = [decimalSum decimalNumberByAdding:KQSKeyPathGetterDecimalNumber(&number)];
+    }
+
+    if (!integral) {
+        return @(doubleSum);
+    }
+    return decimalSum ?: @(integerSum);
+}
+- (id)extremeObjectInObjects:(id<NSFastEnumeration>)objects maximum:(BOOL)maximum {
+    id retval = nil;
+    KQSKeyPathNumber best, number;
+    BOOL numeric = YES;
+
+    for (id object in objects) {
+        if ([self getNumber:&number forObject:object]) {
+            NSComparisonResult result;
+            
+            if (retval == nil) {
+                result = maximum ? NSOrderedDescending : NSOrderedAscending;
+            }
+            else if (number.integral && best.integral) {
+                result = KQSKeyPathGetterCompareIntegers(&number, &best);
+            }
+            else {
+                result = number.doubleValue > best.doubleValue ? NSOrderedDescending : number.doubleValue < best.doubleValue ? NSOrderedAscending : NSOrderedSame;
+            }
+            
+            if (result == (maximum ? NSOrderedDescending : NSOrderedAscending)) {
+                retval = object;
+                best = number;
+            }
+        }
+        else {
+            id value = [self valueForObject:object];
+            
+            if (value != nil &&
+                value != [NSNull null]) {
+                
+                numeric = NO;
+                break;
+            }
+        }
+    }
+
+    if (numeric) {
+        return retval;
+    }
+
+    // at least one value is not a number, compare all of them using compare: like KQS_maximum
+    id bestValue = nil;
+
+    retval = nil;
+
+    for (id object in objects) {
+        id value = [self valueForObject:object];
+        
+        if (value == nil ||
+            value == [NSNull null]) {
+            
+            continue;
+        }
+        
+        if (bestValue == nil ||
+            [value compare:bestValue] == (maximum ? NSOrderedDescending : NSOrderedAscending)) {
+            
+            retval = object;
+            bestValue = value;
+        }
+    }
+
+    return retval;
+}
+- (NSArray *)sortObjects:(NSArray *)objects bySources:(NSArray *)sources ascending:(BOOL)ascending {
+    NSParameterAssert(objects.count == sources.count);
+
+    NSUInteger count = objects.count;
+    NSMutableArray *values = [[NSMutableArray alloc] initWithCapacity:count];
+    NSMutableArray<NSNumber *> *indexes = [[NSMutableArray alloc] initWithCapacity:count];
+
+    // read every value once up front rather than twice per comparison
+    for (NSUInteger i=0; i<count; i++) {
+        [values addObject:[self valueForObject:sources[i]] ?: [NSNull null]];
+        [indexes addObject:@(i)];
+    }
+
+    [indexes sortWithOptions:NSSortStable usingComparator:^NSComparisonResult(NSNumber *first, NSNumber *second) {
+        id firstValue = values[first.unsignedIntegerValue], secondValue = values[second.unsignedIntegerValue];
+        NSComparisonResult result;
+        
+        if (firstValue == secondValue) {
+            result = NSOrderedSame;
+        }
+        else if (firstValue == [NSNull null]) {
+            result = NSOrderedAscending;
+        }
+        else if (secondValue == [NSNull null]) {
+            result = NSOrderedDescending;
+        }
+        else {
+            result = [firstValue compare:secondValue];
+        }
+        
+        return ascending ? result : (NSComparisonResult)-result;
+    }];
+
+    NSMutableArray *retval = [[NSMutableArray alloc] initWithCapacity:count];
+
+    for (NSNumber *index in indexes) {
+        [retval addObject:objects[index.unsignedIntegerValue]];
+    }
+
+    return [retval copy];
+}
+
+@end
@@ -0,0 +1,315 @@
+//
+//  KQSPersistentVector.h
+//  Quicksilver
+//
+//  Created by William Towe on 10/19/26.
+//  Copyright © 2021 Kosoku Interactive, LLC. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#import <Foundation/Foundation.h>
+#import <CoreGraphics/CGBase.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ KQSPersistentVector is an immutable, ordered collection backed by a relaxed radix balanced tree with a branching factor of 32. Every operation that returns a modified vector shares all untouched nodes with the receiver, so appending, replacing, slicing and concatenating are O(log n) in both time and memory, regardless of the number of versions kept alive. Concatenation redistributes the nodes along the seam so that each level holds at most two more nodes than it needs, which keeps the tree O(log n) deep no matter how the vector was built.
+
+ Indexed access is O(log n) with a very small constant (a vector of one million objects is four levels deep). Enumeration using NSFastEnumeration or the KQS operators visits the leaves in order and is O(n).
+ */
+@interface KQSPersistentVector<__covariant ObjectType> : NSObject <NSCopying, NSFastEnumeration>
+
+/**
+ The number of objects in the receiver.
+ */
+@property (readonly,nonatomic) NSUInteger count;
+/**
+ The first object in the receiver, or nil if the receiver is empty.
+ */
+@property (readonly,nonatomic,nullable) ObjectType firstObject;
+/**
+ The last object in the receiver, or nil if the receiver is empty.
+ */
+@property (readonly,nonatomic,nullable) ObjectType lastObject;
+/**
+ Returns an array containing the objects in the receiver, in order. This is O(n).
+ */
+@property (readonly,nonatomic) NSArray<ObjectType> *array;
+
+/**
+ Creates and returns an empty vector.
+
+ @return The empty vector
+ */
++ (instancetype)vector;
+/**
+ Creates and returns a vector containing the objects in *array*.
+
+ @param array The array of objects
+ @return The new vector
+ @exception NSException Thrown if array is nil
+ */
++ (instancetype)vectorWithArray:(NSArray<ObjectType> *)array;
+
+/**
+ Creates and returns a vector containing the objects in *array*. This is O(n), the objects are packed into full leaves.
+
+ @param array The array of objects
+ @return The initialized vector
+ @exception NSException Thrown if array is nil
+ */
+- (instancetype)initWithArray:(NSArray<ObjectType> *)array;
+
+/**
+ Returns the object at *index*.
+
+ @param index The index of the object
+ @return The object
+ @exception NSRangeException Thrown if index >= self.count
+ */
+- (ObjectType)objectAtIndex:(NSUInteger)index;
+/**
+ Returns the result of `[self objectAtIndex:index]`.
+
+ @param index The index of the object
+ @return The object
+ @exception NSRangeException Thrown if index >= self.count
+ */
+- (ObjectType)objectAtIndexedSubscript:(NSUInteger)index;
+
+/**
+ Returns a new vector containing the objects in the receiver followed by *object*.
+
+ @param object The object to append
+ @return The new vector
+ @exception NSException Thrown if object is nil
+ */
+- (KQSPersistentVector<ObjectType> *)vectorByAddingObject:(ObjectType)object;
+/**
+ Returns a new vector containing the objects in the receiver followed by the objects in *array*.
+
+ @param array The array of objects to append
+ @return The new vector
+ @exception NSException Thrown if array is nil
+ */
+- (KQSPersistentVector<ObjectType> *)vectorByAddingObjectsFromArray:(NSArray<ObjectType> *)array;
+/**
+ Returns a new vector containing the objects in the receiver followed by the objects in *vector*. Both vectors share their nodes with the result.
+
+ @param vector The vector to concatenate
+ @return The new vector
+ @exception NSException Thrown if vector is nil
+ */
+- (KQSPersistentVector<ObjectType> *)vectorByAddingObjectsFromVector:(KQSPersistentVector<ObjectType> *)vector;
+/**
+ Returns a new vector with the object at *index* replaced by *object*.
+
+ @param index The index of the object to replace
+ @param object The replacement object
+ @return The new vector
+ @exception NSRangeException Thrown if index >= self.count
+ */
+- (KQSPersistentVector<ObjectType> *)vectorByReplacingObjectAtIndex:(NSUInteger)index withObject:(ObjectType)object;
+/**
+ Returns a new vector containing the objects in the receiver within *range*.
+
+ @param range The range of objects
+ @return The new vector
+ @exception NSRangeException Thrown if NSMaxRange(range) > self.count
+ */
+- (KQSPersistentVector<ObjectType> *)subvectorWithRange:(NSRange)range;
+
+/**
+ Returns YES if *vector* contains equal objects in the same order as the receiver, otherwise NO.
+
+ @param vector The vector to compare
+ @return YES if the vectors are equal, otherwise NO
+ */
+- (BOOL)isEqualToVector:(KQSPersistentVector *)vector;
+
+/**
+ Invokes block once for each object in the receiver.
+
+ @param block The block to invoke
+ @exception NSException Thrown if block is nil
+ */
+- (void)KQS_each:(void(^)(ObjectType object, NSInteger index))block;
+/**
+ Create and return a new vector by enumerating the receiver, invoking block for each object, and including it in the new vector if block returns YES.
+
+ @param block The block to invoke for each object in the receiver
+ @return The new vector
+ @exception NSException Thrown if block is nil
+ */
+- (KQSPersistentVector<ObjectType> *)KQS_filter:(BOOL(^)(ObjectType object, NSInteger index))block;
+/**
+ Create and return a new vector by enumerating the receiver, invoking block for each object, and including it in the new vector if block returns NO.
+
+ @param block The block to invoke for each object in the receiver
+ @return The new vector
+ @exception NSException Thrown if block is nil
+ */
+- (KQSPersistentVector<ObjectType> *)KQS_reject:(BOOL(^)(ObjectType object, NSInteger index))block;
+/**
+ Return the first object in the receiver for which block returns YES, or nil if block returns NO for all objects in the receiver.
+
+ @param block The block to invoke for each object in the receiver
+ @return The matching object or nil
+ @exception NSException Thrown if block is nil
+ */
+- (nullable ObjectType)KQS_find:(BOOL(^)(ObjectType object, NSInteger index))block;
+/**
+ Return an array of the first object in the receiver along with its index for which block returns YES, or nil if block returns NO for all objects in the receiver.
+
+ @param block The block to invoke for each object in the receiver
+ @return An array where the first object is an object in the receiver and second object is the index of the object in the receiver, or nil
+ @exception NSException Thrown if block is nil
+ */
+- (nullable NSArray *)KQS_findWithIndex:(BOOL(^)(ObjectType object, NSInteger index))block;
+/**
+ Create and return a new vector by enumerating the receiver, invoking block for each object, and including the return value of block in the new vector. If block returns nil, [NSNull null] is used instead.
+
+ @param block The block to invoke for each object in the receiver
+ @return The new vector
+ @exception NSException Thrown if block is nil
+ */
+- (KQSPersistentVector *)KQS_map:(id _Nullable(^)(ObjectType object, NSInteger index))block;
+/**
+ Return a new object that is the result of enumerating the receiver and invoking block, passing the current sum, the object, and the index of object in the receiver. The return value of block is passed in as sum to the next invocation of block.
+
+ @param start The starting value for the reduction
+ @param block The block to invoke for each object in the receiver
+ @return The result of the reduction
+ @exception NSException Thrown if block is nil
+ */
+- (nullable id)KQS_reduceWithStart:(nullable id)start block:(id _Nullable(^)(id _Nullable sum, ObjectType object, NSInteger index))block;
+/**
+ Return the result of enumerating the receiver and invoking block, passing the current sum, the object, and the index of object in the receiver, without boxing the sum.
+
+ @param start The starting float value for the reduction
+ @param block The float specific block to use during the reduction
+ @return The final float value
+ @exception NSException Thrown if block is nil
+ */
+- (CGFloat)KQS_reduceFloatWithStart:(CGFloat)start block:(CGFloat(^)(CGFloat sum, ObjectType object, NSInteger index))block;
+/**
+ Return the result of enumerating the receiver and invoking block, passing the current sum, the object, and the index of object in the receiver, without boxing the sum.
+
+ @param start The starting integer value for the reduction
+ @param block The integer specific block to use during the reduction
+ @return The final integer value
+ @exception NSException Thrown if block is nil
+ */
+- (NSInteger)KQS_reduceIntegerWithStart:(NSInteger)start block:(NSInteger(^)(NSInteger sum, ObjectType object, NSInteger index))block;
+/**
+ Return a new vector that is a result of recursively flattening the objects in the receiver, which can either be arrays, vectors or other objects.
+
+ @return The flattened vector
+ */
+- (KQSPersistentVector *)KQS_flatten;
+/**
+ Return YES if block returns YES for any object in the receiver, otherwise NO.
+
+ @param block The block to invoke for each object in the receiver
+ @return YES if block returns YES for any object, otherwise NO
+ @exception NSException Thrown if block is nil
+ */
+- (BOOL)KQS_any:(BOOL(^)(ObjectType object, NSInteger index))block;
+/**
+ Return YES if block returns YES for all objects in the receiver, otherwise NO.
+
+ @param block The block to invoke for each object in the receiver
+ @return YES if block returns YES for all objects, otherwise NO
+ @exception NSException Thrown if block is nil
+ */
+- (BOOL)KQS_all:(BOOL(^)(ObjectType object, NSInteger index))block;
+/**
+ Returns YES if block returns NO for all objects in the receiver, otherwise NO.
+
+ @param block The block to invoke for all objects in the receiver
+ @return YES if block returns NO for all objects, otherwise NO
+ @exception NSException Thrown if block is nil
+ */
+- (BOOL)KQS_none:(BOOL(^)(ObjectType object, NSInteger index))block;
+/**
+ Returns a new vector created by taking the first count objects in the receiver. If count > self.count, returns self. Like -[NSArray KQS_take:], count is compared unsigned, so a negative count returns self. This is O(log n) and shares nodes with the receiver.
+
+ @param count The number of objects to take from the beginning of the receiver
+ @return The new vector
+ */
+- (KQSPersistentVector<ObjectType> *)KQS_take:(NSInteger)count;
+/**
+ Returns the largest prefix of the receiver for which block returns YES.
+
+ @param block The block to invoke for each object in the receiver
+ @return The prefix vector
+ @exception NSException Thrown if block is nil
+ */
+- (KQSPersistentVector<ObjectType> *)KQS_takeWhile:(BOOL(^)(ObjectType object, NSInteger index))block;
+/**
+ Returns a new vector created by dropping count objects from the beginning of the receiver. If count > self.count, returns an empty vector. Like -[NSArray KQS_drop:], count is compared unsigned, so a negative count returns an empty vector. This is O(log n) and shares nodes with the receiver.
+
+ @param count The number of objects to drop from the beginning of the receiver
+ @return The suffix vector
+ */
+- (KQSPersistentVector<ObjectType> *)KQS_drop:(NSInteger)count;
+/**
+ Returns the remainder of the receiver after block returns NO for an object in the receiver. If block returns YES for all objects in the receiver, returns an empty vector.
+
+ @param block The block to invoke for each object in the receiver
+ @return The suffix vector
+ @exception NSException Thrown if block is nil
+ */
+- (KQSPersistentVector<ObjectType> *)KQS_dropWhile:(BOOL(^)(ObjectType object, NSInteger index))block;
+/**
+ Returns a new vector created by taking pairs of objects from the receiver and vector. If either vector has more objects than the other, the extra objects are not included in the return value.
+
+ @param vector The vector to zip with
+ @return The new vector of two element arrays
+ @exception NSException Thrown if vector is nil
+ */
+- (KQSPersistentVector<NSArray *> *)KQS_zip:(KQSPersistentVector *)vector;
+/**
+ Returns the sum of the objects in the receiver, which should be NSNumber instances, as an NSNumber. The type of the first object decides how the objects are added, exactly like -[NSArray KQS_sum].
+
+ @return The sum
+ */
+- (__kindof NSNumber *)KQS_sum;
+/**
+ Returns the sum of the objects in the receiver, which should be NSNumber instances, as a double NSNumber, using Neumaier's compensated summation like -[NSArray KQS_sumPrecise].
+
+ @return The sum
+ */
+- (__kindof NSNumber *)KQS_sumPrecise;
+/**
+ Returns the product of the objects in the receiver, which should be NSNumber instances, as an NSNumber. The type of the first object decides how the objects are multiplied, exactly like -[NSArray KQS_product].
+
+ @return The product
+ */
+- (__kindof NSNumber *)KQS_product;
+/**
+ Returns the maximum value of the objects in the receiver, which should all respond to the `compare:` method, or nil if the receiver is empty.
+
+ @return The maximum value
+ */
+- (nullable ObjectType)KQS_maximum;
+/**
+ Returns the minimum value of the objects in the receiver, which should all respond to the `compare:` method, or nil if the receiver is empty.
+
+ @return The minimum value
+ */
+- (nullable ObjectType)KQS_minimum;
+
+@end
+
+NS_ASSUME_NONNULL_END
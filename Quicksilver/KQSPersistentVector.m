@@ -0,0 +1,819 @@
+//
+//  KQSPersistentVector.m
+//  Quicksilver
+//
+//  Created by William Towe on 10/19/26.
+//  Copyright © 2021 Kosoku Interactive, LLC. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#import "KQSPersistentVector.h"
+#import "NSArray+KQSExtensions.h"
+#import "KQSSummation.h"
+
+static NSUInteger const kKQSPersistentVectorBranchFactor = 32;
+// how many more nodes than the minimum a level may hold after concatenation, each costs at most one extra step when searching for an index
+static NSUInteger const kKQSPersistentVectorExtraSearchSteps = 2;
+
+/**
+ Nodes are immutable once created. A leaf node holds up to kKQSPersistentVectorBranchFactor objects, an internal node holds up to kKQSPersistentVectorBranchFactor child nodes along with a table of cumulative child counts, which lets child nodes be only partially full (required for O(log n) slicing and concatenation).
+ */
+@interface KQSPersistentVectorNode : NSObject {
+    NSUInteger *_sizes;
+}
+@property (readonly,nonatomic,getter=isLeaf) BOOL leaf;
+@property (readonly,nonatomic) NSArray *children;
+@property (readonly,nonatomic) NSUInteger count;
+
+- (instancetype)initWithObjects:(NSArray *)objects;
+- (instancetype)initWithNodes:(NSArray<KQSPersistentVectorNode *> *)nodes;
+
+- (NSUInteger)indexOfChildContainingIndex:(NSUInteger)index;
+- (NSUInteger)countBeforeChildAtIndex:(NSUInteger)index;
+@end
+
+@implementation KQSPersistentVectorNode
+
+- (void)dealloc {
+    free(_sizes);
+}
+
+- (instancetype)initWithObjects:(NSArray *)objects {
+    if (!(self = [super init]))
+        return nil;
+
+    _leaf = YES;
+    _children = [objects copy];
+    _count = _children.count;
+
+    return self;
+}
+- (instancetype)initWithNodes:(NSArray<KQSPersistentVectorNode *> *)nodes {
+    if (!(self = [super init]))
+        return nil;
+
+    _children = [nodes copy];
+    _sizes = malloc(sizeof(NSUInteger) * MAX(_children.count, 1));
+
+    NSUInteger total = 0, index = 0;
+
+    for (KQSPersistentVectorNode *node in _children) {
+        total += node.count;
+        _sizes[index++] = total;
+    }
+
+    _count = total;
+
+    return self;
+}
+
+- (NSUInteger)indexOfChildContainingIndex:(NSUInteger)index {
+    NSUInteger low = 0, high = _children.count - 1;
+
+    while (low < high) {
+        NSUInteger mid = (low + high) / 2;
+
+        if (_sizes[mid] > index) {
+            high = mid;
+        }
+        else {
+            low = mid + 1;
+        }
+    }
+    return low;
+}
+- (NSUInteger)countBeforeChildAtIndex:(NSUInteger)index {
+    return index == 0 ? 0 : _sizes[index - 1];
+}
+
+@end
+
+static KQSPersistentVectorNode *KQSPersistentVectorNodeByReplacing(KQSPersistentVectorNode *node, NSUInteger index, id object) {
+    if (node.isLeaf) {
+        NSMutableArray *objects = [node.children mutableCopy];
+
+        objects[index] = object;
+
+        return [[KQSPersistentVectorNode alloc] initWithObjects:objects];
+    }
+
+    NSUInteger childIndex = [node indexOfChildContainingIndex:index];
+    NSMutableArray *children = [node.children mutableCopy];
+
+    children[childIndex] = KQSPersistentVectorNodeByReplacing(children[childIndex], index - [node countBeforeChildAtIndex:childIndex], object);
+
+    return [[KQSPersistentVectorNode alloc] initWithNodes:children];
+}
+static KQSPersistentVectorNode *KQSPersistentVectorNodePath(NSUInteger height, id object) {
+    KQSPersistentVectorNode *retval = [[KQSPersistentVectorNode alloc] initWithObjects:@[object]];
+
+    while (height-- > 0) {
+        retval = [[KQSPersistentVectorNode alloc] initWithNodes:@[retval]];
+    }
+    return retval;
+}
+// returns nil if the subtree rooted at node has no room for object at its right edge
+static KQSPersistentVectorNode *KQSPersistentVectorNodeByAdding(KQSPersistentVectorNode *node, NSUInteger height, id object) {
+    if (node.isLeaf) {
+        if (node.children.count >= kKQSPersistentVectorBranchFactor) {
+            return nil;
+        }
+        return [[KQSPersistentVectorNode alloc] initWithObjects:[node.children arrayByAddingObject:object]];
+    }
+
+    NSMutableArray *children = [node.children mutableCopy];
+    KQSPersistentVectorNode *child = KQSPersistentVectorNodeByAdding(children.lastObject, height - 1, object);
+
+    if (child != nil) {
+        children[children.count - 1] = child;
+    }
+    else if (children.count < kKQSPersistentVectorBranchFactor) {
+        [children addObject:KQSPersistentVectorNodePath(height - 1, object)];
+    }
+    else {
+        return nil;
+    }
+    return [[KQSPersistentVectorNode alloc] initWithNodes:children];
+}
+// keeps the first count objects, 0 < count <= node.count
+static KQSPersistentVectorNode *KQSPersistentVectorNodeTake(KQSPersistentVectorNode *node, NSUInteger count) {
+    if (node.isLeaf) {
+        return [[KQSPersistentVectorNode alloc] initWithObjects:[node.children subarrayWithRange:NSMakeRange(0, count)]];
+    }
+
+    NSUInteger childIndex = [node indexOfChildContainingIndex:count - 1];
+    NSMutableArray *children = [[node.children subarrayWithRange:NSMakeRange(0, childIndex)] mutableCopy];
+
+    [children addObject:KQSPersistentVectorNodeTake(node.children[childIndex], count - [node countBeforeChildAtIndex:childIndex])];
+
+    return [[KQSPersistentVectorNode alloc] initWithNodes:children];
+}
+// drops the first count objects, 0 <= count < node.count
+static KQSPersistentVectorNode *KQSPersistentVectorNodeDrop(KQSPersistentVectorNode *node, NSUInteger count) {
+    if (node.isLeaf) {
+        return [[KQSPersistentVectorNode alloc] initWithObjects:[node.children subarrayWithRange:NSMakeRange(count, node.children.count - count)]];
+    }
+
+    NSUInteger childIndex = [node indexOfChildContainingIndex:count];
+    NSMutableArray *children = [NSMutableArray arrayWithObject:KQSPersistentVectorNodeDrop(node.children[childIndex], count - [node countBeforeChildAtIndex:childIndex])];
+
+    [children addObjectsFromArray:[node.children subarrayWithRange:NSMakeRange(childIndex + 1, node.children.count - childIndex - 1)]];
+
+    return [[KQSPersistentVectorNode alloc] initWithNodes:children];
+}
+// redistributes the contents of sibling nodes of the same height so that there are at most kKQSPersistentVectorExtraSearchSteps more of them than are needed to hold their contents, which is the RRB concatenation invariant that keeps the tree O(log n) deep under repeated concatenation
+static NSArray<KQSPersistentVectorNode *> *KQSPersistentVectorNodeRebalance(NSArray<KQSPersistentVectorNode *> *children) {
+    NSUInteger count = children.count, slots = 0;
+
+    for (KQSPersistentVectorNode *child in children) {
+        slots += child.children.count;
+    }
+
+    NSUInteger optimal = (slots + kKQSPersistentVectorBranchFactor - 1) / kKQSPersistentVectorBranchFactor;
+
+    if (count <= optimal + kKQSPersistentVectorExtraSearchSteps) {
+        return children;
+    }
+
+    NSUInteger *sizes = malloc(sizeof(NSUInteger) * count);
+
+    for (NSUInteger i=0; i<count; i++) {
+        sizes[i] = children[i].children.count;
+    }
+
+    while (count > optimal + kKQSPersistentVectorExtraSearchSteps) {
+        NSUInteger i = 0;
+
+        // skip the nodes that are nearly full, there is always an emptier one before the last node while the invariant does not hold
+        while (sizes[i] > kKQSPersistentVectorBranchFactor - kKQSPersistentVectorExtraSearchSteps / 2) {
+            i++;
+        }
+
+        // spread the contents of node i over the nodes after it, removing one node
+        NSUInteger remaining = sizes[i];
+
+        while (remaining > 0) {
+            NSUInteger size = MIN(remaining + sizes[i + 1], kKQSPersistentVectorBranchFactor);
+
+            remaining = remaining + sizes[i + 1] - size;
+            sizes[i++] = size;
+        }
+
+        memmove(sizes + i, sizes + i + 1, sizeof(NSUInteger) * (count - i - 1));
+        count--;
+    }
+
+    NSMutableArray *retval = [[NSMutableArray alloc] initWithCapacity:count];
+    BOOL leaves = children.firstObject.isLeaf;
+    NSUInteger childIndex = 0, offset = 0;
+
+    for (NSUInteger i=0; i<count; i++) {
+        KQSPersistentVectorNode *child = children[childIndex];
+
+        // nodes left alone by the redistribution are shared rather than copied
+        if (offset == 0 &&
+            child.children.count == sizes[i]) {
+
+            [retval addObject:child];
+            childIndex++;
+            continue;
+        }
+
+        NSMutableArray *contents = [[NSMutableArray alloc] initWithCapacity:sizes[i]];
+
+        while (contents.count < sizes[i]) {
+            child = children[childIndex];
+
+            NSUInteger length = MIN(sizes[i] - contents.count, child.children.count - offset);
+
+            [contents addObjectsFromArray:[child.children subarrayWithRange:NSMakeRange(offset, length)]];
+            offset += length;
+
+            if (offset == child.children.count) {
+                childIndex++;
+                offset = 0;
+            }
+        }
+
+        [retval addObject:leaves ? [[KQSPersistentVectorNode alloc] initWithObjects:contents] : [[KQSPersistentVectorNode alloc] initWithNodes:contents]];
+    }
+
+    free(sizes);
+
+    return retval;
+}
+// packs at most twice the branch factor of sibling nodes into one or two parent nodes
+static NSArray<KQSPersistentVectorNode *> *KQSPersistentVectorNodePack(NSArray<KQSPersistentVectorNode *> *children) {
+    if (children.count <= kKQSPersistentVectorBranchFactor) {
+        return @[[[KQSPersistentVectorNode alloc] initWithNodes:children]];
+    }
+
+    NSUInteger half = (children.count + 1) / 2;
+
+    return @[[[KQSPersistentVectorNode alloc] initWithNodes:[children subarrayWithRange:NSMakeRange(0, half)]],
+             [[KQSPersistentVectorNode alloc] initWithNodes:[children subarrayWithRange:NSMakeRange(half, children.count - half)]]];
+}
+// joins left and right along their seam, rebalancing the nodes on the seam at every level, returns one or two nodes of height MAX(leftHeight, rightHeight)
+static NSArray<KQSPersistentVectorNode *> *KQSPersistentVectorNodeConcat(KQSPersistentVectorNode *left, NSUInteger leftHeight, KQSPersistentVectorNode *right, NSUInteger rightHeight) {
+    NSMutableArray *children;
+
+    if (leftHeight > rightHeight) {
+        children = [[left.children subarrayWithRange:NSMakeRange(0, left.children.count - 1)] mutableCopy];
+        [children addObjectsFromArray:KQSPersistentVectorNodeConcat(left.children.lastObject, leftHeight - 1, right, rightHeight)];
+    }
+    else if (leftHeight < rightHeight) {
+        children = [KQSPersistentVectorNodeConcat(left, leftHeight, right.children.firstObject, rightHeight - 1) mutableCopy];
+        [children addObjectsFromArray:[right.children subarrayWithRange:NSMakeRange(1, right.children.count - 1)]];
+    }
+    else if (left.isLeaf) {
+        if (left.count + right.count <= kKQSPersistentVectorBranchFactor) {
+            return @[[[KQSPersistentVectorNode alloc] initWithObjects:[left.children arrayByAddingObjectsFromArray:right.children]]];
+        }
+        return @[left,right];
+    }
+    else {
+        children = [[left.children subarrayWithRange:NSMakeRange(0, left.children.count - 1)] mutableCopy];
+        [children addObjectsFromArray:KQSPersistentVectorNodeConcat(left.children.lastObject, leftHeight - 1, right.children.firstObject, rightHeight - 1)];
+        [children addObjectsFromArray:[right.children subarrayWithRange:NSMakeRange(1, right.children.count - 1)]];
+    }
+    return KQSPersistentVectorNodePack(KQSPersistentVectorNodeRebalance(children));
+}
+
+@interface KQSPersistentVector ()
+@property (strong,nonatomic,nullable) KQSPersistentVectorNode *root;
+@property (assign,nonatomic) NSUInteger height;
+
+- (instancetype)initWithRoot:(nullable KQSPersistentVectorNode *)root height:(NSUInteger)height NS_DESIGNATED_INITIALIZER;
+@end
+
+@implementation KQSPersistentVector
+
+- (BOOL)isEqual:(id)object {
+    return self == object || ([object isKindOfClass:KQSPersistentVector.class] && [self isEqualToVector:object]);
+}
+- (NSUInteger)hash {
+    return self.count;
+}
+- (NSString *)description {
+    return [NSString stringWithFormat:@"<%@: %p> %@",NSStringFromClass(self.class),self,self.array];
+}
+
+- (id)copyWithZone:(NSZone *)zone {
+    return self;
+}
+
+- (NSUInteger)countByEnumeratingWithState:(NSFastEnumerationState *)state objects:(id __unsafe_unretained [])buffer count:(NSUInteger)len {
+    NSUInteger index = state->state;
+
+    if (index >= self.count) {
+        return 0;
+    }
+
+    KQSPersistentVectorNode *node = self.root;
+    NSUInteger offset = index;
+
+    while (!node.isLeaf) {
+        NSUInteger childIndex = [node indexOfChildContainingIndex:offset];
+
+        offset -= [node countBeforeChildAtIndex:childIndex];
+        node = node.children[childIndex];
+    }
+
+    NSUInteger count = MIN(len, node.children.count - offset);
+
+    [node.children getObjects:buffer range:NSMakeRange(offset, count)];
+
+    state->state = index + count;
+    state->itemsPtr = buffer;
+    // the receiver is immutable, any stable address will do
+    state->mutationsPtr = &state->extra[0];
+
+    return count;
+}
+
+- (instancetype)init {
+    return [self initWithArray:@[]];
+}
+- (instancetype)initWithArray:(NSArray *)array {
+    NSParameterAssert(array);
+
+    if (array.count == 0) {
+        return [self initWithRoot:nil height:0];
+    }
+
+    NSMutableArray *nodes = [[NSMutableArray alloc] initWithCapacity:array.count / kKQSPersistentVectorBranchFactor + 1];
+    NSUInteger height = 0;
+
+    for (NSUInteger i=0; i<array.count; i+=kKQSPersistentVectorBranchFactor) {
+        [nodes addObject:[[KQSPersistentVectorNode alloc] initWithObjects:[array subarrayWithRange:NSMakeRange(i, MIN(kKQSPersistentVectorBranchFactor, array.count - i))]]];
+    }
+
+    while (nodes.count > 1) {
+        NSMutableArray *parents = [[NSMutableArray alloc] initWithCapacity:nodes.count / kKQSPersistentVectorBranchFactor + 1];
+
+        for (NSUInteger i=0; i<nodes.count; i+=kKQSPersistentVectorBranchFactor) {
+            [parents addObject:[[KQSPersistentVectorNode alloc] initWithNodes:[nodes subarrayWithRange:NSMakeRange(i, MIN(kKQSPersistentVectorBranchFactor, nodes.count - i))]]];
+        }
+
+        nodes = parents;
+        height++;
+    }
+
+    return [self initWithRoot:nodes.firstObject height:height];
+}
+- (instancetype)initWithRoot:(KQSPersistentVectorNode *)root height:(NSUInteger)height {
+    if (!(self = [super init]))
+        return nil;
+
+    // collapse single child roots left behind by slicing
+    while (height > 0 && root.children.count == 1) {
+        root = root.children.firstObject;
+        height--;
+    }
+
+    _root = root;
+    _height = height;
+
+    return self;
+}
+
++ (instancetype)vector {
+    return [[self alloc] init];
+}
++ (instancetype)vectorWithArray:(NSArray *)array {
+    return [[self alloc] initWithArray:array];
+}
+
+- (id)objectAtIndex:(NSUInteger)index {
+    if (index >= self.count) {
+        [NSException raise:NSRangeException format:@"%@: index %@ beyond bounds [0 .. %@]",NSStringFromSelector(_cmd),@(index),@((NSInteger)self.count - 1)];
+    }
+
+    KQSPersistentVectorNode *node = self.root;
+
+    while (!node.isLeaf) {
+        NSUInteger childIndex = [node indexOfChildContainingIndex:index];
+
+        index -= [node countBeforeChildAtIndex:childIndex];
+        node = node.children[childIndex];
+    }
+
+    return node.children[index];
+}
+- (id)objectAtIndexedSubscript:(NSUInteger)index {
+    return [self objectAtIndex:index];
+}
+
+- (KQSPersistentVector *)vectorByAddingObject:(id)object {
+    NSParameterAssert(object);
+
+    if (self.root == nil) {
+        return [[KQSPersistentVector alloc] initWithArray:@[object]];
+    }
+
+    KQSPersistentVectorNode *root = KQSPersistentVectorNodeByAdding(self.root, self.height, object);
+
+    if (root != nil) {
+        return [[KQSPersistentVector alloc] initWithRoot:root height:self.height];
+    }
+    return [[KQSPersistentVector alloc] initWithRoot:[[KQSPersistentVectorNode alloc] initWithNodes:@[self.root,KQSPersistentVectorNodePath(self.height, object)]] height:self.height + 1];
+}
+- (KQSPersistentVector *)vectorByAddingObjectsFromArray:(NSArray *)array {
+    return [self vectorByAddingObjectsFromVector:[[KQSPersistentVector alloc] initWithArray:array]];
+}
+- (KQSPersistentVector *)vectorByAddingObjectsFromVector:(KQSPersistentVector *)vector {
+    NSParameterAssert(vector);
+
+    if (vector.count == 0) {
+        return self;
+    }
+    else if (self.count == 0) {
+        return vector;
+    }
+
+    NSArray *nodes = KQSPersistentVectorNodeConcat(self.root, self.height, vector.root, vector.height);
+    NSUInteger height = MAX(self.height, vector.height);
+
+    if (nodes.count == 1) {
+        return [[KQSPersistentVector alloc] initWithRoot:nodes.firstObject height:height];
+    }
+    return [[KQSPersistentVector alloc] initWithRoot:[[KQSPersistentVectorNode alloc] initWithNodes:nodes] height:height + 1];
+}
+- (KQSPersistentVector *)vectorByReplacingObjectAtIndex:(NSUInteger)index withObject:(id)object {
+    NSParameterAssert(object);
+
+    if (index >= self.count) {
+        [NSException raise:NSRangeException format:@"%@: index %@ beyond bounds [0 .. %@]",NSStringFromSelector(_cmd),@(index),@((NSInteger)self.count - 1)];
+    }
+
+    return [[KQSPersistentVector alloc] initWithRoot:KQSPersistentVectorNodeByReplacing(self.root, index, object) height:self.height];
+}
+- (KQSPersistentVector *)subvectorWithRange:(NSRange)range {
+    if (NSMaxRange(range) > self.count) {
+        [NSException raise:NSRangeException format:@"%@: range %@ beyond bounds [0 .. %@]",NSStringFromSelector(_cmd),NSStringFromRange(range),@(self.count)];
+    }
+
+    if (range.length == 0) {
+        return [[KQSPersistentVector alloc] init];
+    }
+    else if (range.length == self.count) {
+        return self;
+    }
+
+    KQSPersistentVectorNode *root = self.root;
+
+    if (range.location > 0) {
+        root = KQSPersistentVectorNodeDrop(root, range.location);
+    }
+    if (range.length < root.count) {
+        root = KQSPersistentVectorNodeTake(root, range.length);
+    }
+
+    return [[KQSPersistentVector alloc] initWithRoot:root height:self.height];
+}
+
+- (BOOL)isEqualToVector:(KQSPersistentVector *)vector {
+    if (self == vector) {
+        return YES;
+    }
+    else if (self.count != vector.count) {
+        return NO;
+    }
+
+    NSUInteger index = 0;
+
+    for (id object in self) {
+        if (![object isEqual:vector[index++]]) {
+            return NO;
+        }
+    }
+    return YES;
+}
+
+- (void)KQS_each:(void(^)(id object, NSInteger index))block {
+    NSParameterAssert(block);
+
+    NSInteger index = 0;
+
+    for (id object in self) {
+        block(object,index++);
+    }
+}
+- (KQSPersistentVector *)KQS_filter:(BOOL(^)(id object, NSInteger index))block {
+    NSParameterAssert(block);
+
+    NSMutableArray *retval = [[NSMutableArray alloc] init];
+    NSInteger index = 0;
+
+    for (id object in self) {
+        if (block(object,index++)) {
+            [retval addObject:object];
+        }
+    }
+
+    return [[KQSPersistentVector alloc] initWithArray:retval];
+}
+- (KQSPersistentVector *)KQS_reject:(BOOL(^)(id object, NSInteger index))block {
+    NSParameterAssert(block);
+
+    return [self KQS_filter:^BOOL(id object, NSInteger index) {
+        return !block(object,index);
+    }];
+}
+- (id)KQS_find:(BOOL(^)(id object, NSInteger index))block {
+    NSParameterAssert(block);
+
+    NSInteger index = 0;
+
+    for (id object in self) {
+        if (block(object,index++)) {
+            return object;
+        }
+    }
+    return nil;
+}
+- (NSArray *)KQS_findWithIndex:(BOOL(^)(id object, NSInteger index))block {
+    NSParameterAssert(block);
+
+    NSInteger index = 0;
+
+    for (id object in self) {
+        if (block(object,index)) {
+            return @[object,@(index)];
+        }
+        index++;
+    }
+    return nil;
+}
+- (KQSPersistentVector *)KQS_map:(id _Nullable(^)(id object, NSInteger index))block {
+    NSParameterAssert(block);
+
+    NSMutableArray *retval = [[NSMutableArray alloc] initWithCapacity:self.count];
+    NSInteger index = 0;
+
+    for (id object in self) {
+        [retval addObject:block(object,index++) ?: [NSNull null]];
+    }
+
+    return [[KQSPersistentVector alloc] initWithArray:retval];
+}
+- (id)KQS_reduceWithStart:(id)start block:(id _Nullable(^)(id sum, id object, NSInteger index))block {
+    NSParameterAssert(block);
+
+    id retval = start;
+    NSInteger index = 0;
+
+    for (id object in self) {
+        retval = block(retval,object,index++);
+    }
+
+    return retval;
+}
+- (CGFloat)KQS_reduceFloatWithStart:(CGFloat)start block:(CGFloat(^)(CGFloat sum, id object, NSInteger index))block {
+    NSParameterAssert(block);
+
+    CGFloat retval = start;
+    NSInteger index = 0;
+
+    for (id object in self) {
+        retval = block(retval,object,index++);
+    }
+
+    return retval;
+}
+- (NSInteger)KQS_reduceIntegerWithStart:(NSInteger)start block:(NSInteger(^)(NSInteger sum, id object, NSInteger index))block {
+    NSParameterAssert(block);
+
+    NSInteger retval = start;
+    NSInteger index = 0;
+
+    for (id object in self) {
+        retval = block(retval,object,index++);
+    }
+
+    return retval;
+}
+- (KQSPersistentVector *)KQS_flatten {
+    NSMutableArray *retval = [[NSMutableArray alloc] initWithCapacity:self.count];
+
+    for (id object in self) {
+        if ([object isKindOfClass:NSArray.class]) {
+            [retval addObjectsFromArray:[object KQS_flatten]];
+        }
+        else if ([object isKindOfClass:KQSPersistentVector.class]) {
+            [retval addObjectsFromArray:[object KQS_flatten].array];
+        }
+        else {
+            [retval addObject:object];
+        }
+    }
+
+    return [[KQSPersistentVector alloc] initWithArray:retval];
+}
+- (BOOL)KQS_any:(BOOL(^)(id object, NSInteger index))block {
+    NSParameterAssert(block);
+
+    NSInteger index = 0;
+
+    for (id object in self) {
+        if (block(object,index++)) {
+            return YES;
+        }
+    }
+    return NO;
+}
+- (BOOL)KQS_all:(BOOL(^)(id object, NSInteger index))block {
+    NSParameterAssert(block);
+
+    NSInteger index = 0;
+
+    for (id object in self) {
+        if (!block(object,index++)) {
+            return NO;
+        }
+    }
+    return YES;
+}
+- (BOOL)KQS_none:(BOOL(^)(id object, NSInteger index))block {
+    return ![self KQS_any:block];
+}
+- (KQSPersistentVector *)KQS_take:(NSInteger)count {
+    // compared unsigned like -[NSArray KQS_take:], so a negative count takes every object
+    if ((NSUInteger)count > self.count) {
+        return self;
+    }
+    return [self subvectorWithRange:NSMakeRange(0, count)];
+}
+- (KQSPersistentVector *)KQS_takeWhile:(BOOL(^)(id object, NSInteger index))block {
+    NSParameterAssert(block);
+
+    NSInteger index = 0;
+
+    for (id object in self) {
+        if (!block(object,index)) {
+            break;
+        }
+        index++;
+    }
+
+    return [self KQS_take:index];
+}
+- (KQSPersistentVector *)KQS_drop:(NSInteger)count {
+    // compared unsigned like -[NSArray KQS_drop:], so a negative count drops every object
+    if ((NSUInteger)count > self.count) {
+        return [[KQSPersistentVector alloc] init];
+    }
+    return [self subvectorWithRange:NSMakeRange(count, self.count - count)];
+}
+- (KQSPersistentVector *)KQS_dropWhile:(BOOL(^)(id object, NSInteger index))block {
+    NSParameterAssert(block);
+
+    NSInteger index = 0;
+
+    for (id object in self) {
+        if (!block(object,index)) {
+            break;
+        }
+        index++;
+    }
+
+    return [self KQS_drop:index];
+}
+- (KQSPersistentVector *)KQS_zip:(KQSPersistentVector *)vector {
+    NSParameterAssert(vector);
+
+    NSUInteger count = MIN(self.count, vector.count);
+    NSMutableArray *retval = [[NSMutableArray alloc] initWithCapacity:count];
+    NSUInteger index = 0;
+
+    for (id object in self) {
+        if (index >= count) {
+            break;
+        }
+        [retval addObject:@[object,vector[index++]]];
+    }
+
+    return [[KQSPersistentVector alloc] initWithArray:retval];
+}
+- (NSNumber *)KQS_sum {
+    NSNumber *first = self.firstObject;
+
+    if (first == nil) {
+        return @0;
+    }
+    else if ([first isKindOfClass:[NSDecimalNumber class]]) {
+        NSDecimalNumber *retval = [NSDecimalNumber zero];
+
+        for (NSDecimalNumber *number in self) {
+            retval = [retval decimalNumberByAdding:number];
+        }
+        return retval;
+    }
+    else if (strcmp(first.objCType, @encode(double)) == 0 ||
+             strcmp(first.objCType, @encode(float)) == 0) {
+
+        double retval = 0.0;
+
+        for (NSNumber *number in self) {
+            retval += number.doubleValue;
+        }
+        return @(retval);
+    }
+
+    NSInteger retval = 0;
+
+    for (NSNumber *number in self) {
+        retval += number.integerValue;
+    }
+    return @(retval);
+}
+- (NSNumber *)KQS_sumPrecise {
+    return @(KQSSummationPrecise(self));
+}
+- (NSNumber *)KQS_product {
+    NSNumber *first = self.firstObject;
+
+    if (first == nil) {
+        return @0;
+    }
+    else if ([first isKindOfClass:[NSDecimalNumber class]]) {
+        NSDecimalNumber *retval = [NSDecimalNumber one];
+
+        for (NSDecimalNumber *number in self) {
+            retval = [retval decimalNumberByMultiplyingBy:number];
+        }
+        return retval;
+    }
+    else if (strcmp(first.objCType, @encode(double)) == 0 ||
+             strcmp(first.objCType, @encode(float)) == 0) {
+
+        double retval = 1.0;
+
+        for (NSNumber *number in self) {
+            retval *= number.doubleValue;
+        }
+        return @(retval);
+    }
+
+    NSInteger retval = 1;
+
+    for (NSNumber *number in self) {
+        retval *= number.integerValue;
+    }
+    return @(retval);
+}
+- (id)KQS_maximum {
+    id retval = nil;
+
+    for (id object in self) {
+        if (retval == nil ||
+            [object compare:retval] == NSOrderedDescending) {
+
+            retval = object;
+        }
+    }
+    return retval;
+}
+- (id)KQS_minimum {
+    id retval = nil;
+
+    for (id object in self) {
+        if (retval == nil ||
+            [object compare:retval] == NSOrderedAscending) {
+
+            retval = object;
+        }
+    }
+    return retval;
+}
+
+- (NSUInteger)count {
+    return self.root.count;
+}
+- (id)firstObject {
+    return self.count > 0 ? [self objectAtIndex:0] : nil;
+}
+- (id)lastObject {
+    return self.count > 0 ? [self objectAtIndex:self.count - 1] : nil;
+}
+- (NSArray *)array {
+    NSMutableArray *retval = [[NSMutableArray alloc] initWithCapacity:self.count];
+
+    for (id object in self) {
+        [retval addObject:object];
+    }
+
+    return [retval copy];
+}
+
+@end
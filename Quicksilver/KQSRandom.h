@@ -0,0 +1,102 @@
+//
+//  KQSRandom.h
+//  Quicksilver
+//
+//  Created by William Towe on 10/19/26.
+//  Copyright © 2021 Kosoku Interactive, LLC. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ KQSRandom is a fast, seedable pseudorandom number generator (xoshiro256**), along with the sampling algorithms used by the KQS_sample methods. Generators created with the same seed produce the same sequence, which makes sampling and shuffling reproducible. It is not suitable for cryptography.
+
+ Instances are not thread safe, create one per thread.
+ */
+@interface KQSRandom : NSObject
+
+/**
+ The seed the receiver was created with.
+ */
+@property (readonly,assign,nonatomic) uint64_t seed;
+
+/**
+ Creates and returns a generator with a random seed.
+
+ @return The initialized generator
+ */
+- (instancetype)init;
+/**
+ Creates and returns a generator with the provided *seed*.
+
+ @param seed The seed
+ @return The initialized generator
+ */
+- (instancetype)initWithSeed:(uint64_t)seed NS_DESIGNATED_INITIALIZER;
+
+/**
+ Returns the next 64 random bits.
+
+ @return The random value
+ */
+- (uint64_t)nextValue;
+/**
+ Returns a random value between 0 inclusive and *bound* exclusive, without modulo bias.
+
+ @param bound The upper bound
+ @return The random value
+ @exception NSException Thrown if bound is 0
+ */
+- (NSUInteger)nextValueBelow:(NSUInteger)bound;
+/**
+ Returns a random value between 0 inclusive and 1 exclusive.
+
+ @return The random value
+ */
+- (double)nextDouble;
+
+/**
+ Fills *indexes* with *count* distinct random indexes between 0 inclusive and *bound* exclusive, in random order. This is a Fisher-Yates shuffle of the range that stops after count steps and only remembers the positions it has swapped, so it takes O(count) expected time and memory regardless of bound.
+
+ @param indexes The buffer to fill, which must have room for count indexes
+ @param count The number of indexes
+ @param bound The upper bound
+ @exception NSException Thrown if count is greater than bound
+ */
+- (void)getIndexes:(NSUInteger *)indexes count:(NSUInteger)count below:(NSUInteger)bound;
+/**
+ Returns *count* objects chosen uniformly at random without replacement from *objects*, in random order, in a single pass. This is reservoir sampling (Algorithm L), which keeps only count objects in memory and draws random numbers only for the objects that enter the reservoir, so *objects* can be an NSEnumerator or any other stream whose count is unknown. If *objects* has count or fewer objects, all of them are returned.
+
+ @param objects The objects to sample
+ @param count The number of objects to sample
+ @return The sampled objects
+ @exception NSException Thrown if objects is nil
+ */
+- (NSArray *)sampleObjects:(id<NSFastEnumeration>)objects count:(NSUInteger)count;
+/**
+ Returns *count* objects chosen at random without replacement from *objects*, where the chance of choosing each object is proportional to the weight returned by *block*, in a single pass. The objects are returned in the order they were chosen. Objects whose weight is not positive are never chosen, so fewer than count objects are returned if fewer than count objects have a positive weight. This is weighted reservoir sampling (Efraimidis-Spirakis), which keeps only count objects in memory.
+
+ @param objects The objects to sample
+ @param count The number of objects to sample
+ @param block The block returning the weight of each object
+ @return The sampled objects
+ @exception NSException Thrown if objects or block are nil
+ */
+- (NSArray *)sampleObjects:(id<NSFastEnumeration>)objects count:(NSUInteger)count weight:(double(^)(id object, NSInteger index))block;
+
+@end
+
+NS_ASSUME_NONNULL_END
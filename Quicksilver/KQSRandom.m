@@ -0,0 +1,332 @@
+//
+//  KQSRandom.m
+//  Quicksilver
+//
+//  Created by William Towe on 10/19/26.
+//  Copyright © 2021 Kosoku Interactive, LLC. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#import "KQSRandom.h"
+#import "NSMutableArray+KQSExtensions.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct {
+    double key;
+    NSUInteger slot;
+} KQSRandomWeightedEntry;
+
+static inline uint64_t KQSRandomRotate(uint64_t value, int count) {
+    return (value << count) | (value >> (64 - count));
+}
+// splitmix64, used to expand the seed into the four words of state
+static inline uint64_t KQSRandomSplitMix(uint64_t *state) {
+    uint64_t retval = (*state += 0x9E3779B97F4A7C15ULL);
+
+    retval = (retval ^ (retval >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    retval = (retval ^ (retval >> 27)) * 0x94D049BB133111EBULL;
+
+    return retval ^ (retval >> 31);
+}
+// linear probing, NSUIntegerMax marks an empty slot because it is never a valid index
+static inline NSUInteger KQSRandomFindSlot(const NSUInteger *keys, NSUInteger mask, NSUInteger key) {
+    NSUInteger slot = (NSUInteger)(((uint64_t)key * 0x9E3779B97F4A7C15ULL) >> 32) & mask;
+
+    while (keys[slot] != key &&
+           keys[slot] != NSUIntegerMax) {
+
+        slot = (slot + 1) & mask;
+    }
+
+    return slot;
+}
+static inline void KQSRandomSwapEntries(KQSRandomWeightedEntry *heap, NSUInteger first, NSUInteger second) {
+    KQSRandomWeightedEntry temp = heap[first];
+
+    heap[first] = heap[second];
+    heap[second] = temp;
+}
+// the weighted reservoir is a min heap on key, so the root is the entry the next chosen object replaces
+static void KQSRandomSiftUp(KQSRandomWeightedEntry *heap, NSUInteger index) {
+    while (index > 0) {
+        NSUInteger parent = (index - 1) / 2;
+
+        if (heap[parent].key <= heap[index].key) {
+            return;
+        }
+
+        KQSRandomSwapEntries(heap, parent, index);
+        index = parent;
+    }
+}
+static void KQSRandomSiftDown(KQSRandomWeightedEntry *heap, NSUInteger count, NSUInteger index) {
+    while (YES) {
+        NSUInteger smallest = index, left = index * 2 + 1, right = left + 1;
+
+        if (left < count &&
+            heap[left].key < heap[smallest].key) {
+
+            smallest = left;
+        }
+        if (right < count &&
+            heap[right].key < heap[smallest].key) {
+
+            smallest = right;
+        }
+
+        if (smallest == index) {
+            return;
+        }
+
+        KQSRandomSwapEntries(heap, smallest, index);
+        index = smallest;
+    }
+}
+static int KQSRandomCompareEntriesDescending(const void *first, const void *second) {
+    double firstKey = ((const KQSRandomWeightedEntry *)first)->key, secondKey = ((const KQSRandomWeightedEntry *)second)->key;
+
+    return firstKey < secondKey ? 1 : firstKey > secondKey ? -1 : 0;
+}
+
+@interface KQSRandom () {
+    uint64_t _state[4];
+}
+@property (readwrite,assign,nonatomic) uint64_t seed;
+@end
+
+@implementation KQSRandom
+
+- (instancetype)init {
+    uint8_t bytes[16];
+    uint64_t first, second;
+
+    // a version 4 UUID is random apart from a few fixed bits, which land in different places in each half
+    [[NSUUID UUID] getUUIDBytes:bytes];
+
+    memcpy(&first, bytes, sizeof(first));
+    memcpy(&second, bytes + sizeof(first), sizeof(second));
+
+    return [self initWithSeed:first ^ second];
+}
+- (instancetype)initWithSeed:(uint64_t)seed {
+    if (!(self = [super init]))
+        return nil;
+
+    _seed = seed;
+
+    uint64_t state = seed;
+
+    for (NSUInteger i=0; i<4; i++) {
+        _state[i] = KQSRandomSplitMix(&state);
+    }
+
+    return self;
+}
+
+- (uint64_t)nextValue {
+    // xoshiro256**
+    uint64_t retval = KQSRandomRotate(_state[1] * 5, 7) * 9;
+    uint64_t shifted = _state[1] << 17;
+
+    _state[2] ^= _state[0];
+    _state[3] ^= _state[1];
+    _state[1] ^= _state[2];
+    _state[0] ^= _state[3];
+    _state[2] ^= shifted;
+    _state[3] = KQSRandomRotate(_state[3], 45);
+
+    return retval;
+}
+- (NSUInteger)nextValueBelow:(NSUInteger)bound {
+    NSParameterAssert(bound > 0);
+
+    // values below threshold would make the modulo favor small results
+    uint64_t threshold = (0 - (uint64_t)bound) % bound;
+    uint64_t value;
+
+    do {
+        value = [self nextValue];
+    } while (value < threshold);
+
+    return (NSUInteger)(value % bound);
+}
+- (double)nextDouble {
+    return (double)([self nextValue] >> 11) * 0x1.0p-53;
+}
+
+- (void)getIndexes:(NSUInteger *)indexes count:(NSUInteger)count below:(NSUInteger)bound {
+    NSParameterAssert(count <= bound);
+
+    if (count == 0) {
+        return;
+    }
+
+    NSUInteger capacity = 2;
+
+    while (capacity < count * 2) {
+        capacity <<= 1;
+    }
+
+    // once the table would be as large as the range, a dense partial shuffle is cheaper
+    if (capacity * 2 >= bound) {
+        NSUInteger *positions = malloc(bound * sizeof(NSUInteger));
+
+        for (NSUInteger i=0; i<bound; i++) {
+            positions[i] = i;
+        }
+
+        for (NSUInteger i=0; i<count; i++) {
+            NSUInteger j = i + [self nextValueBelow:bound - i];
+            NSUInteger temp = positions[j];
+
+            positions[j] = positions[i];
+            positions[i] = temp;
+            indexes[i] = temp;
+        }
+
+        free(positions);
+        return;
+    }
+
+    // maps each position that has been swapped to the index it now holds, every other position holds its own index
+    NSUInteger *keys = malloc(capacity * sizeof(NSUInteger));
+    NSUInteger *values = malloc(capacity * sizeof(NSUInteger));
+    NSUInteger mask = capacity - 1;
+
+    memset(keys, 0xFF, capacity * sizeof(NSUInteger));
+
+    for (NSUInteger i=0; i<count; i++) {
+        NSUInteger j = i + [self nextValueBelow:bound - i];
+        NSUInteger jSlot = KQSRandomFindSlot(keys, mask, j);
+        NSUInteger iSlot = KQSRandomFindSlot(keys, mask, i);
+        NSUInteger jValue = keys[jSlot] == j ? values[jSlot] : j;
+        NSUInteger iValue = keys[iSlot] == i ? values[iSlot] : i;
+
+        indexes[i] = jValue;
+
+        // position i is never read again, so only position j needs updating
+        keys[jSlot] = j;
+        values[jSlot] = iValue;
+    }
+
+    free(keys);
+    free(values);
+}
+- (NSArray *)sampleObjects:(id<NSFastEnumeration>)objects count:(NSUInteger)count {
+    NSParameterAssert(objects);
+
+    if (count == 0) {
+        return @[];
+    }
+
+    NSMutableArray *retval = [[NSMutableArray alloc] initWithCapacity:MIN(count, 1024)];
+    double weight = 0.0;
+    NSUInteger index = 0, next = 0;
+
+    for (id object in objects) {
+        if (index < count) {
+            [retval addObject:object];
+
+            if (index + 1 == count) {
+                weight = exp(log(1.0 - [self nextDouble]) / (double)count);
+                next = [self nextReservoirIndexAfterIndex:index weight:weight];
+            }
+        }
+        else if (index == next) {
+            retval[[self nextValueBelow:count]] = object;
+
+            weight *= exp(log(1.0 - [self nextDouble]) / (double)count);
+            next = [self nextReservoirIndexAfterIndex:index weight:weight];
+        }
+
+        index++;
+    }
+
+    // the first count objects fill the reservoir in order, shuffle so the order is random as well
+    [retval KQS_shuffleWithRandom:self];
+
+    return [retval copy];
+}
+- (NSArray *)sampleObjects:(id<NSFastEnumeration>)objects count:(NSUInteger)count weight:(double(^)(id object, NSInteger index))block {
+    NSParameterAssert(objects);
+    NSParameterAssert(block);
+
+    if (count == 0) {
+        return @[];
+    }
+
+    NSMutableArray *chosen = [[NSMutableArray alloc] initWithCapacity:MIN(count, 1024)];
+    KQSRandomWeightedEntry *heap = malloc(MIN(count, 1024) * sizeof(KQSRandomWeightedEntry));
+    NSUInteger heapCapacity = MIN(count, 1024), heapCount = 0;
+    NSInteger index = 0;
+
+    for (id object in objects) {
+        double weight = block(object,index++);
+
+        // also rejects NaN
+        if (!(weight > 0.0)) {
+            continue;
+        }
+
+        // each object gets the key u^(1/weight), compared as its logarithm, and the count largest keys are kept
+        double key = log(1.0 - [self nextDouble]) / weight;
+
+        if (heapCount < count) {
+            if (heapCount == heapCapacity) {
+                heapCapacity = MIN(heapCapacity * 2, count);
+                heap = realloc(heap, heapCapacity * sizeof(KQSRandomWeightedEntry));
+            }
+
+            heap[heapCount] = (KQSRandomWeightedEntry){key, heapCount};
+            [chosen addObject:object];
+
+            KQSRandomSiftUp(heap, heapCount);
+            heapCount++;
+        }
+        else if (key > heap[0].key) {
+            chosen[heap[0].slot] = object;
+            heap[0].key = key;
+
+            KQSRandomSiftDown(heap, heapCount, 0);
+        }
+    }
+
+    qsort(heap, heapCount, sizeof(KQSRandomWeightedEntry), KQSRandomCompareEntriesDescending);
+
+    NSMutableArray *retval = [[NSMutableArray alloc] initWithCapacity:heapCount];
+
+    for (NSUInteger i=0; i<heapCount; i++) {
+        [retval addObject:chosen[heap[i].slot]];
+    }
+
+    free(heap);
+
+    return [retval copy];
+}
+#pragma mark *** Private Methods ***
+// jumps over the objects that would not enter the reservoir, the gap is geometrically distributed
+- (NSUInteger)nextReservoirIndexAfterIndex:(NSUInteger)index weight:(double)weight {
+    double skip = floor(log(1.0 - [self nextDouble]) / log1p(-weight));
+
+    // also catches NaN and infinity once weight underflows
+    if (!(skip < (double)(NSUIntegerMax / 2))) {
+        return NSUIntegerMax;
+    }
+
+    return index + (NSUInteger)skip + 1;
+}
+
+@end
@@ -0,0 +1,40 @@
+//
+//  KQSSummation.h
+//  Quicksilver
+//
+//  Created by William Towe on 10/19/26.
+//  Copyright © 2021 Kosoku Interactive, LLC. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ Returns the sum of the doubleValue of each object in *numbers* using Neumaier's variant of Kahan summation, which carries a running compensation for the low order bits lost by each addition. The error is independent of the number of objects, at the cost of a few extra additions per object.
+
+ @param numbers The numbers to sum
+ @return The sum
+ */
+FOUNDATION_EXTERN double KQSSummationPrecise(id<NSFastEnumeration> numbers);
+/**
+ Returns the sum of the doubleValue of each object in *numbers* using blocked pairwise summation, whose error grows with the logarithm of the count rather than linearly. The numbers are summed in fixed size chunks, each using independent accumulators the compiler can vectorize, and the chunk sums are combined pairwise in chunk order. If *concurrent* is YES the chunks are summed on multiple threads, the result is bitwise identical either way.
+
+ @param numbers The numbers to sum
+ @param concurrent Whether to sum the chunks concurrently
+ @return The sum
+ */
+FOUNDATION_EXTERN double KQSSummationPairwise(NSArray *numbers, BOOL concurrent);
+
+NS_ASSUME_NONNULL_END
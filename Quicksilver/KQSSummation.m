@@ -0,0 +1,114 @@
+//
+//  KQSSummation.m
+//  Quicksilver
+//
+//  Created by William Towe on 10/19/26.
+//  Copyright © 2021 Kosoku Interactive, LLC. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#import "KQSSummation.h"
+
+#include <math.h>
+
+// ranges at or below this size are summed directly rather than split further
+static NSUInteger const kKQSSummationBlockSize = 128;
+// the number of independent accumulators used for a block, which maps onto two or four SIMD registers
+#define KQS_SUMMATION_ACCUMULATOR_COUNT 8
+// the chunk size is fixed, rather than derived from the number of threads, so the order of additions never changes
+#define KQS_SUMMATION_CHUNK_SIZE 4096
+
+static double KQSSummationPairwiseDoubles(const double *values, NSUInteger count) {
+    if (count <= kKQSSummationBlockSize) {
+        double accumulators[KQS_SUMMATION_ACCUMULATOR_COUNT] = {0.0};
+        NSUInteger i = 0;
+
+        for (; i + KQS_SUMMATION_ACCUMULATOR_COUNT <= count; i += KQS_SUMMATION_ACCUMULATOR_COUNT) {
+            for (NSUInteger j=0; j<KQS_SUMMATION_ACCUMULATOR_COUNT; j++) {
+                accumulators[j] += values[i + j];
+            }
+        }
+
+        double retval = ((accumulators[0] + accumulators[1]) + (accumulators[2] + accumulators[3])) + ((accumulators[4] + accumulators[5]) + (accumulators[6] + accumulators[7]));
+
+        for (; i<count; i++) {
+            retval += values[i];
+        }
+
+        return retval;
+    }
+
+    // split on a multiple of the accumulator count so both halves use every accumulator
+    NSUInteger half = (count / 2) & ~(NSUInteger)(KQS_SUMMATION_ACCUMULATOR_COUNT - 1);
+
+    return KQSSummationPairwiseDoubles(values, half) + KQSSummationPairwiseDoubles(values + half, count - half);
+}
+static double KQSSummationPairwiseChunk(NSArray *numbers, NSUInteger chunk) {
+    double values[KQS_SUMMATION_CHUNK_SIZE];
+    NSUInteger start = chunk * KQS_SUMMATION_CHUNK_SIZE;
+    NSUInteger count = MIN(numbers.count - start, KQS_SUMMATION_CHUNK_SIZE);
+
+    for (NSUInteger i=0; i<count; i++) {
+        values[i] = [[numbers objectAtIndex:start + i] doubleValue];
+    }
+
+    return KQSSummationPairwiseDoubles(values, count);
+}
+
+double KQSSummationPrecise(id<NSFastEnumeration> numbers) {
+    double sum = 0.0, compensation = 0.0;
+
+    for (NSNumber *number in numbers) {
+        double value = number.doubleValue;
+        double total = sum + value;
+
+        // recover the low order bits of whichever operand was smaller in magnitude
+        if (fabs(sum) >= fabs(value)) {
+            compensation += (sum - total) + value;
+        }
+        else {
+            compensation += (value - total) + sum;
+        }
+
+        sum = total;
+    }
+
+    return sum + compensation;
+}
+double KQSSummationPairwise(NSArray *numbers, BOOL concurrent) {
+    NSUInteger count = numbers.count;
+
+    if (count <= KQS_SUMMATION_CHUNK_SIZE) {
+        return count == 0 ? 0.0 : KQSSummationPairwiseChunk(numbers, 0);
+    }
+
+    NSUInteger chunks = (count + KQS_SUMMATION_CHUNK_SIZE - 1) / KQS_SUMMATION_CHUNK_SIZE;
+    double *partials = malloc(chunks * sizeof(double));
+
+    if (concurrent) {
+        dispatch_apply(chunks, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t chunk) {
+            partials[chunk] = KQSSummationPairwiseChunk(numbers, chunk);
+        });
+    }
+    else {
+        for (NSUInteger chunk=0; chunk<chunks; chunk++) {
+            partials[chunk] = KQSSummationPairwiseChunk(numbers, chunk);
+        }
+    }
+
+    double retval = KQSSummationPairwiseDoubles(partials, chunks);
+
+    free(partials);
+
+    return retval;
+}
@@ -20,6 +20,8 @@
 #import <Foundation/Foundation.h>
 #import <CoreGraphics/CGBase.h>
 
+@class KQSAsyncTask, KQSBloomFilter, KQSHyperLogLog, KQSRandom;
+
 NS_ASSUME_NONNULL_BEGIN
 
 @interface NSArray<__covariant ObjectType> (KQSExtensions)
@@ -188,6 +190,24 @@ NS_ASSUME_NONNULL_BEGIN
  @return The sum
  */
 - (__kindof NSNumber *)KQS_sum;
+/**
+ Returns the sum of the objects in the receiver, which should be NSNumber instances, as a double NSNumber. Uses Neumaier's compensated summation, so the result stays accurate for very large receivers or values of mixed magnitude, unlike KQS_sum which adds the values one after another.
+ 
+ @return The sum
+ */
+- (__kindof NSNumber *)KQS_sumPrecise;
+/**
+ Returns the sum of the objects in the receiver, which should be NSNumber instances, as a double NSNumber. Uses blocked pairwise summation, which is nearly as accurate as KQS_sumPrecise and faster.
+ 
+ @return The sum
+ */
+- (__kindof NSNumber *)KQS_sumPairwise;
+/**
+ Returns the same result as KQS_sumPairwise, summing the receiver in chunks on multiple threads. The chunks are always the same size and combined in the same order, so the result is identical regardless of the number of threads.
+ 
+ @return The sum
+ */
+- (__kindof NSNumber *)KQS_sumPairwiseConcurrently;
 /**
  Returns the product of the objects in the receiver, which should be NSNumber instances, as an NSNumber.
  
@@ -206,6 +226,188 @@ NS_ASSUME_NONNULL_BEGIN
  @return The minimum value
  */
 - (ObjectType)KQS_minimum;
+/**
+ Returns a new array containing the value of *keyPath* for each object in the receiver, in the same order as the receiver, with [NSNull null] substituted for nil. The key path is parsed once and the getter for each class is looked up once, so this is much faster than calling valueForKeyPath: from KQS_map:.
+ 
+ @param keyPath The key path to read from each object
+ @return The new array
+ @exception NSException Thrown if keyPath is nil
+ */
+- (NSArray *)KQS_pluck:(NSString *)keyPath;
+/**
+ Returns a new array containing the objects in the receiver for which the value of *keyPath* is equal to *value*. Nil and [NSNull null] are considered equal.
+ 
+ @param keyPath The key path to read from each object
+ @param value The value to compare to
+ @return The new array
+ @exception NSException Thrown if keyPath is nil
+ */
+- (NSArray<ObjectType> *)KQS_filterWhereKeyPath:(NSString *)keyPath equals:(nullable id)value;
+/**
+ Calls `[self KQS_sortByKeyPath:keyPath ascending:YES]`.
+ 
+ @param keyPath The key path to read from each object
+ @return The sorted array
+ @exception NSException Thrown if keyPath is nil
+ */
+- (NSArray<ObjectType> *)KQS_sortByKeyPath:(NSString *)keyPath;
+/**
+ Returns a new array containing the objects in the receiver sorted by the value of *keyPath*, which should all respond to the `compare:` method. Each value is read once, rather than once per comparison, and nil values sort before all others. The sort is stable.
+ 
+ @param keyPath The key path to read from each object
+ @param ascending Whether to sort ascending or descending
+ @return The sorted array
+ @exception NSException Thrown if keyPath is nil
+ */
+- (NSArray<ObjectType> *)KQS_sortByKeyPath:(NSString *)keyPath ascending:(BOOL)ascending;
+/**
+ Returns the sum of the value of *keyPath* for each object in the receiver as an NSNumber, which is integral if every value is integral. Values that are not NSNumber instances are skipped, scalar getters are read without boxing.
+ 
+ @param keyPath The key path to read from each object
+ @return The sum
+ @exception NSException Thrown if keyPath is nil
+ */
+- (__kindof NSNumber *)KQS_sumOfKeyPath:(NSString *)keyPath;
+/**
+ Returns the object in the receiver with the maximum value of *keyPath*, compared numerically if every value is a number and using `compare:` otherwise. Objects whose value is nil are skipped.
+ 
+ @param keyPath The key path to read from each object
+ @return The object or nil
+ @exception NSException Thrown if keyPath is nil
+ */
+- (nullable ObjectType)KQS_maximumByKeyPath:(NSString *)keyPath;
+/**
+ Returns the object in the receiver with the minimum value of *keyPath*, see KQS_maximumByKeyPath:.
+ 
+ @param keyPath The key path to read from each object
+ @return The object or nil
+ @exception NSException Thrown if keyPath is nil
+ */
+- (nullable ObjectType)KQS_minimumByKeyPath:(NSString *)keyPath;
+/**
+ Returns a dictionary whose keys are the distinct values of *keyPath* for the objects in the receiver, with [NSNull null] substituted for nil, and whose values are arrays of the objects with that value, in the same order as the receiver. The values must conform to NSCopying.
+ 
+ @param keyPath The key path to read from each object
+ @return The dictionary of groups
+ @exception NSException Thrown if keyPath is nil
+ */
+- (NSDictionary<id, NSArray<ObjectType> *> *)KQS_groupByKeyPath:(NSString *)keyPath;
+
+/**
+ Calls `[self KQS_asyncMap:block maxConcurrency:maxConcurrency timeout:0 queue:nil completion:completion]`.
+ 
+ @param block The block to invoke for each object, which must invoke its completion block exactly once
+ @param maxConcurrency The maximum number of invocations of block in flight at once, values <= 0 use the active processor count
+ @param completion The block to invoke with the new array or an error
+ @return The running task, which can be cancelled
+ @exception NSException Thrown if block or completion are nil
+ */
+- (KQSAsyncTask *)KQS_asyncMap:(void(^)(ObjectType object, NSInteger index, void(^completion)(id _Nullable value)))block maxConcurrency:(NSInteger)maxConcurrency completion:(void(^)(NSArray * _Nullable array, NSError * _Nullable error))completion;
+/**
+ Asynchronously create a new array by invoking block for each object in the receiver on *queue*, keeping at most maxConcurrency invocations in flight. The new array has one object per object in the receiver, in the same order, with [NSNull null] used wherever block passed nil to its completion block. Use this instead of KQS_map: when block performs blocking work, such as disk or IPC access.
+ 
+ If any invocation of block does not complete within *timeout* seconds, or the returned task is cancelled, completion is invoked with a nil array and an error in the KQSAsyncTaskErrorDomain.
+ 
+ @param block The block to invoke for each object, which must invoke its completion block exactly once
+ @param maxConcurrency The maximum number of invocations of block in flight at once, values <= 0 use the active processor count
+ @param timeout The per object timeout in seconds, values <= 0 mean no timeout
+ @param queue The queue on which to invoke block and completion, nil means the default priority global queue
+ @param completion The block to invoke with the new array or an error
+ @return The running task, which can be cancelled
+ @exception NSException Thrown if block or completion are nil
+ */
+- (KQSAsyncTask *)KQS_asyncMap:(void(^)(ObjectType object, NSInteger index, void(^completion)(id _Nullable value)))block maxConcurrency:(NSInteger)maxConcurrency timeout:(NSTimeInterval)timeout queue:(nullable dispatch_queue_t)queue completion:(void(^)(NSArray * _Nullable array, NSError * _Nullable error))completion;
+/**
+ Calls `[self KQS_asyncFilter:block maxConcurrency:maxConcurrency timeout:0 queue:nil completion:completion]`.
+ 
+ @param block The block to invoke for each object, which must invoke its completion block exactly once
+ @param maxConcurrency The maximum number of invocations of block in flight at once, values <= 0 use the active processor count
+ @param completion The block to invoke with the new array or an error
+ @return The running task, which can be cancelled
+ @exception NSException Thrown if block or completion are nil
+ */
+- (KQSAsyncTask *)KQS_asyncFilter:(void(^)(ObjectType object, NSInteger index, void(^completion)(BOOL passes)))block maxConcurrency:(NSInteger)maxConcurrency completion:(void(^)(NSArray<ObjectType> * _Nullable array, NSError * _Nullable error))completion;
+/**
+ Asynchronously create a new array containing the objects of the receiver for which block passed YES to its completion block, in the same order as the receiver. Invocations of block are made on *queue* with at most maxConcurrency in flight.
+ 
+ If any invocation of block does not complete within *timeout* seconds, or the returned task is cancelled, completion is invoked with a nil array and an error in the KQSAsyncTaskErrorDomain.
+ 
+ @param block The block to invoke for each object, which must invoke its completion block exactly once
+ @param maxConcurrency The maximum number of invocations of block in flight at once, values <= 0 use the active processor count
+ @param timeout The per object timeout in seconds, values <= 0 mean no timeout
+ @param queue The queue on which to invoke block and completion, nil means the default priority global queue
+ @param completion The block to invoke with the new array or an error
+ @return The running task, which can be cancelled
+ @exception NSException Thrown if block or completion are nil
+ */
+- (KQSAsyncTask *)KQS_asyncFilter:(void(^)(ObjectType object, NSInteger index, void(^completion)(BOOL passes)))block maxConcurrency:(NSInteger)maxConcurrency timeout:(NSTimeInterval)timeout queue:(nullable dispatch_queue_t)queue completion:(void(^)(NSArray<ObjectType> * _Nullable array, NSError * _Nullable error))completion;
+
+/**
+ Calls `[self KQS_bloomFilterWithFalsePositiveRate:falsePositiveRate concurrent:NO]`.
+ 
+ @param falsePositiveRate The desired false positive rate, between 0 and 1 exclusive
+ @return The new filter
+ @exception NSException Thrown if falsePositiveRate is out of range
+ */
+- (KQSBloomFilter *)KQS_bloomFilterWithFalsePositiveRate:(double)falsePositiveRate;
+/**
+ Returns a new KQSBloomFilter containing the objects of the receiver, sized for the receiver's count. If *concurrent* is YES, the objects are hashed on multiple threads, the result is identical either way.
+ 
+ @param falsePositiveRate The desired false positive rate, between 0 and 1 exclusive
+ @param concurrent Whether to hash the objects concurrently
+ @return The new filter
+ @exception NSException Thrown if falsePositiveRate is out of range
+ */
+- (KQSBloomFilter *)KQS_bloomFilterWithFalsePositiveRate:(double)falsePositiveRate concurrent:(BOOL)concurrent;
+/**
+ Returns a new KQSHyperLogLog containing the objects of the receiver. If *concurrent* is YES, the objects are counted in chunks on multiple threads and merged, the result is identical either way.
+ 
+ @param precision The precision, between 4 and 18 inclusive
+ @param concurrent Whether to count the objects concurrently
+ @return The new sketch
+ @exception NSException Thrown if precision is out of range
+ */
+- (KQSHyperLogLog *)KQS_hyperLogLogWithPrecision:(NSUInteger)precision concurrent:(BOOL)concurrent;
+/**
+ Returns an estimate of the number of distinct objects in the receiver, using a KQSHyperLogLog with the default precision. The estimate is usually within 2% and uses a fixed 16KB of memory, regardless of the receiver's count.
+ 
+ @return The approximate distinct count
+ */
+- (NSUInteger)KQS_approximateDistinctCount;
+/**
+ Calls `[self KQS_sample:count random:nil]`.
+ 
+ @param count The number of objects to sample
+ @return The sampled objects
+ */
+- (NSArray<ObjectType> *)KQS_sample:(NSInteger)count;
+/**
+ Returns *count* objects chosen uniformly at random without replacement from the receiver, in random order. Only the chosen indexes are generated, so this takes O(count) expected time and memory regardless of the receiver's count, rather than copying and shuffling the receiver. If count is greater than the receiver's count, every object is returned in random order.
+ 
+ @param count The number of objects to sample
+ @param random The generator to use, or nil to use a new randomly seeded one
+ @return The sampled objects
+ */
+- (NSArray<ObjectType> *)KQS_sample:(NSInteger)count random:(nullable KQSRandom *)random;
+/**
+ Calls `[self KQS_sampleWeighted:count random:nil block:block]`.
+ 
+ @param count The number of objects to sample
+ @param block The block returning the weight of each object
+ @return The sampled objects
+ @exception NSException Thrown if block is nil
+ */
+- (NSArray<ObjectType> *)KQS_sampleWeighted:(NSInteger)count block:(double(^)(ObjectType object, NSInteger index))block;
+/**
+ Returns *count* objects chosen at random without replacement from the receiver, where the chance of choosing each object is proportional to the weight returned by *block*, in the order they were chosen. Objects whose weight is not positive are never chosen. The receiver is read in a single pass, see KQSRandom for details.
+ 
+ @param count The number of objects to sample
+ @param random The generator to use, or nil to use a new randomly seeded one
+ @param block The block returning the weight of each object
+ @return The sampled objects
+ @exception NSException Thrown if block is nil
+ */
+- (NSArray<ObjectType> *)KQS_sampleWeighted:(NSInteger)count random:(nullable KQSRandom *)random block:(double(^)(ObjectType object, NSInteger index))block;
 
 @end
 
@@ -20,8 +20,28 @@
 #import <Foundation/Foundation.h>
 #import <CoreGraphics/CGBase.h>
 
+@class KQSAsyncTask, KQSBloomFilter, KQSHyperLogLog, KQSRandom;
+
 NS_ASSUME_NONNULL_BEGIN
 
+/**
+ Enum describing how duplicate keys are resolved by the deep flatten and unflatten methods. Duplicates are resolved in the enumeration order of the receiver.
+ */
+typedef NS_ENUM(NSInteger, KQSDictionaryConflictPolicy) {
+    /**
+     The value encountered last replaces earlier values, this matches the behavior of addEntriesFromDictionary:.
+     */
+    KQSDictionaryConflictPolicyLastWins = 0,
+    /**
+     The value encountered first is kept, later values are ignored.
+     */
+    KQSDictionaryConflictPolicyFirstWins = 1,
+    /**
+     An NSInvalidArgumentException is thrown.
+     */
+    KQSDictionaryConflictPolicyThrow = 2
+};
+
 @interface NSDictionary<__covariant KeyType, __covariant ObjectType> (KQSExtensions)
 
 /**
@@ -113,6 +133,55 @@ NS_ASSUME_NONNULL_BEGIN
  @exception NSException Thrown if block is nil
  */
 - (NSDictionary *)KQS_flattenMap:(id _Nullable(^)(KeyType key, ObjectType value))block;
+/**
+ Invokes block once for each leaf of the receiver, walking nested dictionaries iteratively, without building any intermediate collections. A leaf is any value that is not a non-empty dictionary. The enumeration stops if block sets stop to YES.
+ 
+ The keyPath passed to block contains the keys leading to the leaf, starting at the receiver. It is reused between invocations of block and must be copied if it is retained beyond the invocation.
+ 
+ @param block The block to invoke for each leaf
+ @exception NSException Thrown if block is nil
+ */
+- (void)KQS_eachLeaf:(void(^)(NSArray *keyPath, id value, BOOL *stop))block;
+/**
+ Returns the result of `[self KQS_flattenDeepWithSeparator:separator conflictPolicy:KQSDictionaryConflictPolicyLastWins]`.
+ 
+ @param separator The separator used to join key paths
+ @return The flattened dictionary
+ @exception NSException Thrown if separator is nil
+ */
+- (NSDictionary<NSString *, id> *)KQS_flattenDeepWithSeparator:(NSString *)separator;
+/**
+ Return a new dictionary which maps the key path of every leaf of the receiver, joined using *separator*, to the leaf value. Non-string keys are converted using their description.
+ 
+ For example, `[@{@"a": @{@"b": @1, @"c": @2}} KQS_flattenDeepWithSeparator:@"."]` -> `@{@"a.b": @1, @"a.c": @2}`.
+ 
+ The receiver is walked iteratively and the returned dictionary is sized by an initial counting pass, so arbitrarily deep and large trees can be flattened without recursion or rehashing.
+ 
+ @param separator The separator used to join key paths
+ @param conflictPolicy How to resolve key paths that join to the same string
+ @return The flattened dictionary
+ @exception NSException Thrown if separator is nil, or if conflictPolicy is KQSDictionaryConflictPolicyThrow and two key paths join to the same string
+ */
+- (NSDictionary<NSString *, id> *)KQS_flattenDeepWithSeparator:(NSString *)separator conflictPolicy:(KQSDictionaryConflictPolicy)conflictPolicy;
+/**
+ Returns the result of `[self KQS_unflattenWithSeparator:@"." conflictPolicy:KQSDictionaryConflictPolicyLastWins]`.
+ 
+ @return The unflattened dictionary
+ */
+- (NSDictionary *)KQS_unflatten;
+/**
+ Return a new dictionary which is the inverse of KQS_flattenDeepWithSeparator:, splitting each string key of the receiver using *separator* and nesting its value under the resulting key path. Non-string keys are copied as is.
+ 
+ For example, `[@{@"a.b": @1, @"a.c": @2} KQS_unflattenWithSeparator:@"."]` -> `@{@"a": @{@"b": @1, @"c": @2}}`.
+ 
+ A conflict occurs when a key path is used for both a leaf and a nested dictionary (e.g. `a` and `a.b`), and is resolved using *conflictPolicy*.
+ 
+ @param separator The separator used to split keys
+ @param conflictPolicy How to resolve conflicting key paths
+ @return The unflattened dictionary
+ @exception NSException Thrown if separator is nil, or if conflictPolicy is KQSDictionaryConflictPolicyThrow and a conflict occurs
+ */
+- (NSDictionary *)KQS_unflattenWithSeparator:(NSString *)separator conflictPolicy:(KQSDictionaryConflictPolicy)conflictPolicy;
 /**
  Returns YES if block returns YES for any key/value pair in the receiver, otherwise NO.
  
@@ -149,6 +218,42 @@ NS_ASSUME_NONNULL_BEGIN
  @return The sum of all values in the receiver
  */
 - (__kindof NSNumber *)KQS_sumOfValues;
+/**
+ Returns the result of `[self.allKeys KQS_sumPrecise]`.
+ 
+ @return The sum of all keys in the receiver
+ */
+- (__kindof NSNumber *)KQS_sumOfKeysPrecise;
+/**
+ Returns the result of `[self.allValues KQS_sumPrecise]`.
+ 
+ @return The sum of all values in the receiver
+ */
+- (__kindof NSNumber *)KQS_sumOfValuesPrecise;
+/**
+ Returns the result of `[self.allKeys KQS_sumPairwise]`.
+ 
+ @return The sum of all keys in the receiver
+ */
+- (__kindof NSNumber *)KQS_sumOfKeysPairwise;
+/**
+ Returns the result of `[self.allKeys KQS_sumPairwiseConcurrently]`.
+ 
+ @return The sum of all keys in the receiver
+ */
+- (__kindof NSNumber *)KQS_sumOfKeysPairwiseConcurrently;
+/**
+ Returns the result of `[self.allValues KQS_sumPairwise]`.
+ 
+ @return The sum of all values in the receiver
+ */
+- (__kindof NSNumber *)KQS_sumOfValuesPairwise;
+/**
+ Returns the result of `[self.allValues KQS_sumPairwiseConcurrently]`.
+ 
+ @return The sum of all values in the receiver
+ */
+- (__kindof NSNumber *)KQS_sumOfValuesPairwiseConcurrently;
 /**
  Returns the result of `[self.allKeys KQS_product]`.
  
@@ -185,6 +290,188 @@ NS_ASSUME_NONNULL_BEGIN
  @return The minimum of all values in the receiver
  */
 - (ObjectType)KQS_minimumValue;
+/**
+ Returns a new dictionary with the same keys as the receiver, whose values are the value of *keyPath* for each value in the receiver, with [NSNull null] substituted for nil. The key path is parsed once and the getter for each class is looked up once, so this is much faster than calling valueForKeyPath: from KQS_map:.
+ 
+ @param keyPath The key path to read from each value
+ @return The new dictionary
+ @exception NSException Thrown if keyPath is nil
+ */
+- (NSDictionary<KeyType, id> *)KQS_pluck:(NSString *)keyPath;
+/**
+ Returns a new dictionary containing the keys and values of the receiver for which the value of *keyPath* for the value is equal to *value*. Nil and [NSNull null] are considered equal.
+ 
+ @param keyPath The key path to read from each value
+ @param value The value to compare to
+ @return The new dictionary
+ @exception NSException Thrown if keyPath is nil
+ */
+- (NSDictionary<KeyType, ObjectType> *)KQS_filterWhereKeyPath:(NSString *)keyPath equals:(nullable id)value;
+/**
+ Calls `[self KQS_sortByKeyPath:keyPath ascending:YES]`.
+ 
+ @param keyPath The key path to read from each value
+ @return The sorted keys
+ @exception NSException Thrown if keyPath is nil
+ */
+- (NSArray<KeyType> *)KQS_sortByKeyPath:(NSString *)keyPath;
+/**
+ Returns the keys of the receiver sorted by the value of *keyPath* for their values, which should all respond to the `compare:` method. Nil values sort before all others.
+ 
+ @param keyPath The key path to read from each value
+ @param ascending Whether to sort ascending or descending
+ @return The sorted keys
+ @exception NSException Thrown if keyPath is nil
+ */
+- (NSArray<KeyType> *)KQS_sortByKeyPath:(NSString *)keyPath ascending:(BOOL)ascending;
+/**
+ Returns the sum of the value of *keyPath* for each value in the receiver as an NSNumber, which is integral if every value is integral. Values that are not NSNumber instances are skipped, scalar getters are read without boxing.
+ 
+ @param keyPath The key path to read from each value
+ @return The sum
+ @exception NSException Thrown if keyPath is nil
+ */
+- (__kindof NSNumber *)KQS_sumOfKeyPath:(NSString *)keyPath;
+/**
+ Returns the value in the receiver with the maximum value of *keyPath*, compared numerically if every value is a number and using `compare:` otherwise. Values whose key path value is nil are skipped.
+ 
+ @param keyPath The key path to read from each value
+ @return The value or nil
+ @exception NSException Thrown if keyPath is nil
+ */
+- (nullable ObjectType)KQS_maximumByKeyPath:(NSString *)keyPath;
+/**
+ Returns the value in the receiver with the minimum value of *keyPath*, see KQS_maximumByKeyPath:.
+ 
+ @param keyPath The key path to read from each value
+ @return The value or nil
+ @exception NSException Thrown if keyPath is nil
+ */
+- (nullable ObjectType)KQS_minimumByKeyPath:(NSString *)keyPath;
+/**
+ Returns a dictionary whose keys are the distinct values of *keyPath* for the values in the receiver, with [NSNull null] substituted for nil, and whose values are dictionaries of the keys and values of the receiver with that key path value. The key path values must conform to NSCopying.
+ 
+ @param keyPath The key path to read from each value
+ @return The dictionary of groups
+ @exception NSException Thrown if keyPath is nil
+ */
+- (NSDictionary<id, NSDictionary<KeyType, ObjectType> *> *)KQS_groupByKeyPath:(NSString *)keyPath;
+
+/**
+ Calls `[self KQS_asyncMap:block maxConcurrency:maxConcurrency timeout:0 queue:nil completion:completion]`.
+ 
+ @param block The block to invoke for each key/value pair, which must invoke its completion block exactly once
+ @param maxConcurrency The maximum number of invocations of block in flight at once, values <= 0 use the active processor count
+ @param completion The block to invoke with the new dictionary or an error
+ @return The running task, which can be cancelled
+ @exception NSException Thrown if block or completion are nil
+ */
+- (KQSAsyncTask *)KQS_asyncMap:(void(^)(KeyType key, ObjectType value, void(^completion)(id _Nullable value)))block maxConcurrency:(NSInteger)maxConcurrency completion:(void(^)(NSDictionary * _Nullable dictionary, NSError * _Nullable error))completion;
+/**
+ Asynchronously create a new dictionary by invoking block for each key/value pair in the receiver on *queue*, keeping at most maxConcurrency invocations in flight. The new dictionary contains all keys from the receiver mapped to the values block passed to its completion block, with [NSNull null] used wherever block passed nil. Use this instead of KQS_map: when block performs blocking work, such as disk or IPC access.
+ 
+ If any invocation of block does not complete within *timeout* seconds, or the returned task is cancelled, completion is invoked with a nil dictionary and an error in the KQSAsyncTaskErrorDomain.
+ 
+ @param block The block to invoke for each key/value pair, which must invoke its completion block exactly once
+ @param maxConcurrency The maximum number of invocations of block in flight at once, values <= 0 use the active processor count
+ @param timeout The per key/value pair timeout in seconds, values <= 0 mean no timeout
+ @param queue The queue on which to invoke block and completion, nil means the default priority global queue
+ @param completion The block to invoke with the new dictionary or an error
+ @return The running task, which can be cancelled
+ @exception NSException Thrown if block or completion are nil
+ */
+- (KQSAsyncTask *)KQS_asyncMap:(void(^)(KeyType key, ObjectType value, void(^completion)(id _Nullable value)))block maxConcurrency:(NSInteger)maxConcurrency timeout:(NSTimeInterval)timeout queue:(nullable dispatch_queue_t)queue completion:(void(^)(NSDictionary * _Nullable dictionary, NSError * _Nullable error))completion;
+/**
+ Calls `[self KQS_asyncFilter:block maxConcurrency:maxConcurrency timeout:0 queue:nil completion:completion]`.
+ 
+ @param block The block to invoke for each key/value pair, which must invoke its completion block exactly once
+ @param maxConcurrency The maximum number of invocations of block in flight at once, values <= 0 use the active processor count
+ @param completion The block to invoke with the new dictionary or an error
+ @return The running task, which can be cancelled
+ @exception NSException Thrown if block or completion are nil
+ */
+- (KQSAsyncTask *)KQS_asyncFilter:(void(^)(KeyType key, ObjectType value, void(^completion)(BOOL passes)))block maxConcurrency:(NSInteger)maxConcurrency completion:(void(^)(NSDictionary<KeyType, ObjectType> * _Nullable dictionary, NSError * _Nullable error))completion;
+/**
+ Asynchronously create a new dictionary containing the key/value pairs of the receiver for which block passed YES to its completion block. Invocations of block are made on *queue* with at most maxConcurrency in flight.
+ 
+ If any invocation of block does not complete within *timeout* seconds, or the returned task is cancelled, completion is invoked with a nil dictionary and an error in the KQSAsyncTaskErrorDomain.
+ 
+ @param block The block to invoke for each key/value pair, which must invoke its completion block exactly once
+ @param maxConcurrency The maximum number of invocations of block in flight at once, values <= 0 use the active processor count
+ @param timeout The per key/value pair timeout in seconds, values <= 0 mean no timeout
+ @param queue The queue on which to invoke block and completion, nil means the default priority global queue
+ @param completion The block to invoke with the new dictionary or an error
+ @return The running task, which can be cancelled
+ @exception NSException Thrown if block or completion are nil
+ */
+- (KQSAsyncTask *)KQS_asyncFilter:(void(^)(KeyType key, ObjectType value, void(^completion)(BOOL passes)))block maxConcurrency:(NSInteger)maxConcurrency timeout:(NSTimeInterval)timeout queue:(nullable dispatch_queue_t)queue completion:(void(^)(NSDictionary<KeyType, ObjectType> * _Nullable dictionary, NSError * _Nullable error))completion;
+
+/**
+ Calls `[self KQS_bloomFilterWithFalsePositiveRate:falsePositiveRate concurrent:NO]`.
+ 
+ @param falsePositiveRate The desired false positive rate, between 0 and 1 exclusive
+ @return The new filter
+ @exception NSException Thrown if falsePositiveRate is out of range
+ */
+- (KQSBloomFilter *)KQS_bloomFilterWithFalsePositiveRate:(double)falsePositiveRate;
+/**
+ Returns a new KQSBloomFilter containing the values of the receiver, sized for the receiver's count. Like KQS_hyperLogLogWithPrecision:concurrent: it uses the values, since a key can already be looked up directly. If *concurrent* is YES, the values are hashed on multiple threads, the result is identical either way.
+ 
+ @param falsePositiveRate The desired false positive rate, between 0 and 1 exclusive
+ @param concurrent Whether to hash the values concurrently
+ @return The new filter
+ @exception NSException Thrown if falsePositiveRate is out of range
+ */
+- (KQSBloomFilter *)KQS_bloomFilterWithFalsePositiveRate:(double)falsePositiveRate concurrent:(BOOL)concurrent;
+/**
+ Returns a new KQSHyperLogLog containing the values of the receiver. If *concurrent* is YES, the values are counted in chunks on multiple threads and merged, the result is identical either way.
+ 
+ @param precision The precision, between 4 and 18 inclusive
+ @param concurrent Whether to count the values concurrently
+ @return The new sketch
+ @exception NSException Thrown if precision is out of range
+ */
+- (KQSHyperLogLog *)KQS_hyperLogLogWithPrecision:(NSUInteger)precision concurrent:(BOOL)concurrent;
+/**
+ Returns an estimate of the number of distinct values in the receiver, using a KQSHyperLogLog with the default precision. The estimate is usually within 2% and uses a fixed 16KB of memory, regardless of the receiver's count.
+ 
+ @return The approximate distinct count
+ */
+- (NSUInteger)KQS_approximateDistinctCount;
+/**
+ Calls `[self KQS_sample:count random:nil]`.
+ 
+ @param count The number of key/value pairs to sample
+ @return The sampled key/value pairs
+ */
+- (NSDictionary<KeyType, ObjectType> *)KQS_sample:(NSInteger)count;
+/**
+ Returns a dictionary of *count* key/value pairs chosen uniformly at random without replacement from the receiver. Dictionaries are not indexed, so this is a single pass reservoir sample over the keys, which takes time proportional to the receiver's count but only keeps count keys in memory. If count is greater than the receiver's count, a copy of the receiver is returned.
+ 
+ @param count The number of key/value pairs to sample
+ @param random The generator to use, or nil to use a new randomly seeded one
+ @return The sampled key/value pairs
+ */
+- (NSDictionary<KeyType, ObjectType> *)KQS_sample:(NSInteger)count random:(nullable KQSRandom *)random;
+/**
+ Calls `[self KQS_sampleWeighted:count random:nil block:block]`.
+ 
+ @param count The number of key/value pairs to sample
+ @param block The block returning the weight of each key/value pair
+ @return The sampled key/value pairs
+ @exception NSException Thrown if block is nil
+ */
+- (NSDictionary<KeyType, ObjectType> *)KQS_sampleWeighted:(NSInteger)count block:(double(^)(KeyType key, ObjectType value))block;
+/**
+ Returns a dictionary of *count* key/value pairs chosen at random without replacement from the receiver, where the chance of choosing each pair is proportional to the weight returned by *block*. Pairs whose weight is not positive are never chosen.
+ 
+ @param count The number of key/value pairs to sample
+ @param random The generator to use, or nil to use a new randomly seeded one
+ @param block The block returning the weight of each key/value pair
+ @return The sampled key/value pairs
+ @exception NSException Thrown if block is nil
+ */
+- (NSDictionary<KeyType, ObjectType> *)KQS_sampleWeighted:(NSInteger)count random:(nullable KQSRandom *)random block:(double(^)(KeyType key, ObjectType value))block;
 
 @end
 
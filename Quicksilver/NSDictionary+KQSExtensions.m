@@ -19,6 +19,64 @@
 
 #import "NSDictionary+KQSExtensions.h"
 #import "NSArray+KQSExtensions.h"
+#import "KQSAsyncTask.h"
+#import "KQSBloomFilter.h"
+#import "KQSHyperLogLog.h"
+#import "KQSRandom.h"
+#import "KQSKeyPathGetter.h"
+
+/**
+ Walks the leaves of dictionary iteratively using an explicit stack, a leaf being any value that is not a non-empty dictionary. If separator is non-nil, the joined key path of each leaf is built incrementally from per level prefixes, otherwise joinedKey is nil. Passing a nil block only counts the leaves.
+ */
+static NSUInteger KQSDictionaryEnumerateLeaves(NSDictionary *dictionary, NSString *separator, void(^block)(NSArray *keyPath, NSString *joinedKey, id value, BOOL *stop)) {
+    NSMutableArray<NSDictionary *> *dictionaries = [NSMutableArray arrayWithObject:dictionary];
+    NSMutableArray<NSEnumerator *> *enumerators = [NSMutableArray arrayWithObject:dictionary.keyEnumerator];
+    NSMutableArray<NSString *> *prefixes = separator == nil ? nil : [NSMutableArray arrayWithObject:@""];
+    NSMutableArray *keyPath = block == nil ? nil : [[NSMutableArray alloc] init];
+    NSUInteger retval = 0;
+    BOOL stop = NO;
+    
+    while (enumerators.count > 0) {
+        id key = [enumerators.lastObject nextObject];
+        
+        if (key == nil) {
+            if (enumerators.count > 1) {
+                [keyPath removeLastObject];
+            }
+            [dictionaries removeLastObject];
+            [enumerators removeLastObject];
+            [prefixes removeLastObject];
+            continue;
+        }
+        
+        id value = dictionaries.lastObject[key];
+        NSString *joinedKey = separator == nil ? nil : [prefixes.lastObject stringByAppendingString:[key isKindOfClass:NSString.class] ? key : [key description]];
+        
+        if ([value isKindOfClass:NSDictionary.class] &&
+            [value count] > 0) {
+            
+            [keyPath addObject:key];
+            [dictionaries addObject:value];
+            [enumerators addObject:[value keyEnumerator]];
+            [prefixes addObject:[joinedKey stringByAppendingString:separator]];
+            continue;
+        }
+        
+        retval++;
+        
+        if (block != nil) {
+            [keyPath addObject:key];
+            block(keyPath,joinedKey,value,&stop);
+            [keyPath removeLastObject];
+            
+            if (stop) {
+                break;
+            }
+        }
+    }
+    
+    return retval;
+}
 
 @implementation NSDictionary (KQSExtensions)
 
@@ -106,9 +164,15 @@
     return retval;
 }
 - (CGFloat)KQS_reduceFloatWithStart:(CGFloat)start block:(CGFloat(^)(CGFloat sum, id key, id value))block; {
-    return [[self KQS_reduceWithStart:@(start) block:^id _Nullable(NSNumber * _Nullable sum, id  _Nonnull key, id  _Nonnull value) {
-        return @(block(sum.floatValue,key,value));
-    }] floatValue];
+    NSParameterAssert(block);
+    
+    __block CGFloat retval = start;
+    
+    [self enumerateKeysAndObjectsUsingBlock:^(id  _Nonnull key, id  _Nonnull obj, BOOL * _Nonnull stop) {
+        retval = block(retval,key,obj);
+    }];
+    
+    return retval;
 }
 - (NSInteger)KQS_reduceIntegerWithStart:(NSInteger)start block:(NSInteger(^)(NSInteger sum, id key, id value))block; {
     return [[self KQS_reduceWithStart:@(start) block:^id _Nullable(NSNumber * _Nullable sum, id  _Nonnull key, id  _Nonnull value) {
@@ -116,7 +180,13 @@
     }] integerValue];
 }
 - (NSDictionary *)KQS_flatten; {
-    return [[self KQS_reduceWithStart:[[NSMutableDictionary alloc] init] block:^id _Nullable(NSMutableDictionary * _Nullable sum, id _Nonnull key, NSDictionary * _Nonnull value) {
+    NSUInteger count = 0;
+    
+    for (NSDictionary *value in self.objectEnumerator) {
+        count += value.count;
+    }
+    
+    return [[self KQS_reduceWithStart:[[NSMutableDictionary alloc] initWithCapacity:count] block:^id _Nullable(NSMutableDictionary * _Nullable sum, id _Nonnull key, NSDictionary * _Nonnull value) {
         [sum addEntriesFromDictionary:value];
         return sum;
     }] copy];
@@ -124,6 +194,121 @@
 - (NSDictionary *)KQS_flattenMap:(id _Nullable(^)(id key, id value))block; {
     return [[self KQS_flatten] KQS_map:block];
 }
+- (void)KQS_eachLeaf:(void(^)(NSArray *keyPath, id value, BOOL *stop))block; {
+    NSParameterAssert(block);
+    
+    KQSDictionaryEnumerateLeaves(self, nil, ^(NSArray *keyPath, NSString *joinedKey, id value, BOOL *stop) {
+        block(keyPath,value,stop);
+    });
+}
+- (NSDictionary<NSString *, id> *)KQS_flattenDeepWithSeparator:(NSString *)separator; {
+    return [self KQS_flattenDeepWithSeparator:separator conflictPolicy:KQSDictionaryConflictPolicyLastWins];
+}
+- (NSDictionary<NSString *, id> *)KQS_flattenDeepWithSeparator:(NSString *)separator conflictPolicy:(KQSDictionaryConflictPolicy)conflictPolicy; {
+    NSParameterAssert(separator);
+    
+    NSMutableDictionary *retval = [[NSMutableDictionary alloc] initWithCapacity:KQSDictionaryEnumerateLeaves(self, nil, nil)];
+    
+    KQSDictionaryEnumerateLeaves(self, separator, ^(NSArray *keyPath, NSString *joinedKey, id value, BOOL *stop) {
+        if (conflictPolicy != KQSDictionaryConflictPolicyLastWins &&
+            retval[joinedKey] != nil) {
+            
+            if (conflictPolicy == KQSDictionaryConflictPolicyThrow) {
+                [NSException raise:NSInvalidArgumentException format:@"%@: duplicate key path %@",NSStringFromSelector(_cmd),joinedKey];
+            }
+            return;
+        }
+        [retval setObject:value forKey:joinedKey];
+    });
+    
+    return [retval copy];
+}
+- (NSDictionary *)KQS_unflatten; {
+    return [self KQS_unflattenWithSeparator:@"." conflictPolicy:KQSDictionaryConflictPolicyLastWins];
+}
+- (NSDictionary *)KQS_unflattenWithSeparator:(NSString *)separator conflictPolicy:(KQSDictionaryConflictPolicy)conflictPolicy; {
+    NSParameterAssert(separator);
+    
+    // every key of the receiver adds at most one key to the root, so its count bounds the root without a counting pass
+    NSMutableDictionary *retval = [[NSMutableDictionary alloc] initWithCapacity:self.count];
+    // the nested dictionaries created below, so they can be told apart from leaf values that happen to be mutable dictionaries
+    NSHashTable *containers = [[NSHashTable alloc] initWithOptions:NSPointerFunctionsStrongMemory|NSPointerFunctionsObjectPointerPersonality capacity:0];
+    
+    // every nested dictionary in the order it was created, along with the dictionary and key it was stored under
+    NSMutableArray<NSMutableDictionary *> *created = [[NSMutableArray alloc] init];
+    NSMutableArray<NSMutableDictionary *> *parents = [[NSMutableArray alloc] init];
+    NSMutableArray *parentKeys = [[NSMutableArray alloc] init];
+    NSMutableDictionary *(^addChild)(NSMutableDictionary *, id) = ^NSMutableDictionary *(NSMutableDictionary *container, id component) {
+        NSMutableDictionary *child = [[NSMutableDictionary alloc] init];
+        
+        [containers addObject:child];
+        [created addObject:child];
+        [parents addObject:container];
+        [parentKeys addObject:component];
+        [container setObject:child forKey:component];
+        
+        return child;
+    };
+    
+    [containers addObject:retval];
+    
+    [self enumerateKeysAndObjectsUsingBlock:^(id _Nonnull key, id _Nonnull obj, BOOL * _Nonnull stop) {
+        NSArray *components = [key isKindOfClass:NSString.class] ? [key componentsSeparatedByString:separator] : @[key];
+        NSMutableDictionary *container = retval;
+        
+        for (NSUInteger i=0; i<components.count; i++) {
+            id component = components[i];
+            id existing = container[component];
+            BOOL last = i == components.count - 1;
+            
+            if (existing == nil) {
+                if (last) {
+                    [container setObject:obj forKey:component];
+                }
+                else {
+                    container = addChild(container, component);
+                }
+                continue;
+            }
+            
+            BOOL existingIsContainer = [containers containsObject:existing];
+            
+            if (!last && existingIsContainer) {
+                container = existing;
+                continue;
+            }
+            
+            // a leaf and a nested dictionary share this key path
+            if (conflictPolicy == KQSDictionaryConflictPolicyThrow) {
+                [NSException raise:NSInvalidArgumentException format:@"%@: conflicting key path %@",NSStringFromSelector(_cmd),key];
+            }
+            else if (conflictPolicy == KQSDictionaryConflictPolicyFirstWins) {
+                break;
+            }
+            
+            if (last) {
+                [container setObject:obj forKey:component];
+            }
+            else {
+                container = addChild(container, component);
+            }
+        }
+    }];
+    
+    // a dictionary is always created after the one containing it, so walking backwards replaces every nested dictionary with an immutable copy before its parent is copied, without recursion
+    for (NSUInteger i=created.count; i>0; i--) {
+        NSMutableDictionary *child = created[i - 1];
+        NSMutableDictionary *parent = parents[i - 1];
+        id parentKey = parentKeys[i - 1];
+        
+        // skip dictionaries that a conflicting key path replaced later on
+        if (parent[parentKey] == child) {
+            [parent setObject:[child copy] forKey:parentKey];
+        }
+    }
+    
+    return [retval copy];
+}
 - (BOOL)KQS_any:(BOOL(^)(id key, id value))block; {
     NSParameterAssert(block);
     
@@ -172,6 +357,24 @@
 - (id)KQS_sumOfValues; {
     return [self.allValues KQS_sum];
 }
+- (id)KQS_sumOfKeysPrecise; {
+    return [self.allKeys KQS_sumPrecise];
+}
+- (id)KQS_sumOfValuesPrecise; {
+    return [self.allValues KQS_sumPrecise];
+}
+- (id)KQS_sumOfKeysPairwise; {
+    return [self.allKeys KQS_sumPairwise];
+}
+- (id)KQS_sumOfKeysPairwiseConcurrently; {
+    return [self.allKeys KQS_sumPairwiseConcurrently];
+}
+- (id)KQS_sumOfValuesPairwise; {
+    return [self.allValues KQS_sumPairwise];
+}
+- (id)KQS_sumOfValuesPairwiseConcurrently; {
+    return [self.allValues KQS_sumPairwiseConcurrently];
+}
 - (id)KQS_productOfKeys {
     return [self.allKeys KQS_product];
 }
@@ -190,5 +393,176 @@
 - (id)KQS_minimumValue; {
     return [self.allValues KQS_minimum];
 }
+- (NSDictionary *)KQS_pluck:(NSString *)keyPath; {
+    NSParameterAssert(keyPath);
+    
+    KQSKeyPathGetter *getter = [[KQSKeyPathGetter alloc] initWithKeyPath:keyPath];
+    NSMutableDictionary *retval = [[NSMutableDictionary alloc] initWithCapacity:self.count];
+    
+    [self enumerateKeysAndObjectsUsingBlock:^(id  _Nonnull key, id  _Nonnull obj, BOOL * _Nonnull stop) {
+        [retval setObject:[getter valueForObject:obj] ?: [NSNull null] forKey:key];
+    }];
+    
+    return [retval copy];
+}
+- (NSDictionary *)KQS_filterWhereKeyPath:(NSString *)keyPath equals:(id)value; {
+    NSParameterAssert(keyPath);
+    
+    KQSKeyPathGetter *getter = [[KQSKeyPathGetter alloc] initWithKeyPath:keyPath];
+    NSMutableDictionary *retval = [[NSMutableDictionary alloc] init];
+    
+    [self enumerateKeysAndObjectsUsingBlock:^(id  _Nonnull key, id  _Nonnull obj, BOOL * _Nonnull stop) {
+        if ([getter valueForObject:obj isEqual:value]) {
+            [retval setObject:obj forKey:key];
+        }
+    }];
+    
+    return [retval copy];
+}
+- (NSArray *)KQS_sortByKeyPath:(NSString *)keyPath; {
+    return [self KQS_sortByKeyPath:keyPath ascending:YES];
+}
+- (NSArray *)KQS_sortByKeyPath:(NSString *)keyPath ascending:(BOOL)ascending; {
+    NSParameterAssert(keyPath);
+    
+    NSMutableArray *keys = [[NSMutableArray alloc] initWithCapacity:self.count];
+    NSMutableArray *values = [[NSMutableArray alloc] initWithCapacity:self.count];
+    
+    [self enumerateKeysAndObjectsUsingBlock:^(id  _Nonnull key, id  _Nonnull obj, BOOL * _Nonnull stop) {
+        [keys addObject:key];
+        [values addObject:obj];
+    }];
+    
+    return [[[KQSKeyPathGetter alloc] initWithKeyPath:keyPath] sortObjects:keys bySources:values ascending:ascending];
+}
+- (NSNumber *)KQS_sumOfKeyPath:(NSString *)keyPath; {
+    NSParameterAssert(keyPath);
+    
+    return [[[KQSKeyPathGetter alloc] initWithKeyPath:keyPath] sumOfObjects:self.objectEnumerator];
+}
+- (id)KQS_maximumByKeyPath:(NSString *)keyPath; {
+    NSParameterAssert(keyPath);
+    
+    return [[[KQSKeyPathGetter alloc] initWithKeyPath:keyPath] extremeObjectInObjects:self.allValues maximum:YES];
+}
+- (id)KQS_minimumByKeyPath:(NSString *)keyPath; {
+    NSParameterAssert(keyPath);
+    
+    return [[[KQSKeyPathGetter alloc] initWithKeyPath:keyPath] extremeObjectInObjects:self.allValues maximum:NO];
+}
+- (NSDictionary *)KQS_groupByKeyPath:(NSString *)keyPath; {
+    NSParameterAssert(keyPath);
+    
+    KQSKeyPathGetter *getter = [[KQSKeyPathGetter alloc] initWithKeyPath:keyPath];
+    NSMutableDictionary *groups = [[NSMutableDictionary alloc] init];
+    
+    [self enumerateKeysAndObjectsUsingBlock:^(id  _Nonnull key, id  _Nonnull obj, BOOL * _Nonnull stop) {
+        id groupKey = [getter valueForObject:obj] ?: [NSNull null];
+        NSMutableDictionary *group = groups[groupKey];
+        
+        if (group == nil) {
+            group = [[NSMutableDictionary alloc] init];
+            groups[groupKey] = group;
+        }
+        
+        [group setObject:obj forKey:key];
+    }];
+    
+    NSMutableDictionary *retval = [[NSMutableDictionary alloc] initWithCapacity:groups.count];
+    
+    [groups enumerateKeysAndObjectsUsingBlock:^(id  _Nonnull key, NSMutableDictionary * _Nonnull obj, BOOL * _Nonnull stop) {
+        retval[key] = [obj copy];
+    }];
+    
+    return [retval copy];
+}
+- (KQSAsyncTask *)KQS_asyncMap:(void(^)(id key, id value, void(^completion)(id _Nullable value)))block maxConcurrency:(NSInteger)maxConcurrency completion:(void(^)(NSDictionary * _Nullable dictionary, NSError * _Nullable error))completion; {
+    return [self KQS_asyncMap:block maxConcurrency:maxConcurrency timeout:0 queue:nil completion:completion];
+}
+- (KQSAsyncTask *)KQS_asyncMap:(void(^)(id key, id value, void(^completion)(id _Nullable value)))block maxConcurrency:(NSInteger)maxConcurrency timeout:(NSTimeInterval)timeout queue:(dispatch_queue_t)queue completion:(void(^)(NSDictionary * _Nullable dictionary, NSError * _Nullable error))completion; {
+    NSParameterAssert(block);
+    NSParameterAssert(completion);
+    
+    NSDictionary *dictionary = [self copy];
+    NSArray *keys = dictionary.allKeys;
+    
+    return [KQSAsyncTask taskWithCount:keys.count maxConcurrency:maxConcurrency timeout:timeout queue:queue block:^(NSInteger index, void (^itemCompletion)(id _Nullable)) {
+        block(keys[index],dictionary[keys[index]],itemCompletion);
+    } completion:^(NSArray * _Nullable values, NSError * _Nullable error) {
+        completion(values == nil ? nil : [NSDictionary dictionaryWithObjects:values forKeys:keys],error);
+    }];
+}
+- (KQSAsyncTask *)KQS_asyncFilter:(void(^)(id key, id value, void(^completion)(BOOL passes)))block maxConcurrency:(NSInteger)maxConcurrency completion:(void(^)(NSDictionary * _Nullable dictionary, NSError * _Nullable error))completion; {
+    return [self KQS_asyncFilter:block maxConcurrency:maxConcurrency timeout:0 queue:nil completion:completion];
+}
+- (KQSAsyncTask *)KQS_asyncFilter:(void(^)(id key, id value, void(^completion)(BOOL passes)))block maxConcurrency:(NSInteger)maxConcurrency timeout:(NSTimeInterval)timeout queue:(dispatch_queue_t)queue completion:(void(^)(NSDictionary * _Nullable dictionary, NSError * _Nullable error))completion; {
+    NSParameterAssert(block);
+    NSParameterAssert(completion);
+    
+    NSDictionary *dictionary = [self copy];
+    NSArray *keys = dictionary.allKeys;
+    
+    return [KQSAsyncTask taskWithCount:keys.count maxConcurrency:maxConcurrency timeout:timeout queue:queue block:^(NSInteger index, void (^itemCompletion)(id _Nullable)) {
+        block(keys[index],dictionary[keys[index]],^(BOOL passes) {
+            itemCompletion(@(passes));
+        });
+    } completion:^(NSArray * _Nullable values, NSError * _Nullable error) {
+        if (values == nil) {
+            completion(nil,error);
+            return;
+        }
+        
+        NSMutableDictionary *retval = [[NSMutableDictionary alloc] init];
+        
+        [values enumerateObjectsUsingBlock:^(NSNumber *passes, NSUInteger idx, BOOL *stop) {
+            if (passes.boolValue) {
+                [retval setObject:dictionary[keys[idx]] forKey:keys[idx]];
+            }
+        }];
+        
+        completion([retval copy],nil);
+    }];
+}
+- (KQSBloomFilter *)KQS_bloomFilterWithFalsePositiveRate:(double)falsePositiveRate; {
+    return [self KQS_bloomFilterWithFalsePositiveRate:falsePositiveRate concurrent:NO];
+}
+- (KQSBloomFilter *)KQS_bloomFilterWithFalsePositiveRate:(double)falsePositiveRate concurrent:(BOOL)concurrent; {
+    // only the concurrent build needs the values by index, the serial build hashes them in place
+    if (!concurrent) {
+        return [KQSBloomFilter bloomFilterWithObjects:self.objectEnumerator capacity:self.count falsePositiveRate:falsePositiveRate];
+    }
+    return [KQSBloomFilter bloomFilterWithArray:self.allValues falsePositiveRate:falsePositiveRate concurrent:YES];
+}
+- (KQSHyperLogLog *)KQS_hyperLogLogWithPrecision:(NSUInteger)precision concurrent:(BOOL)concurrent; {
+    if (!concurrent) {
+        return [KQSHyperLogLog hyperLogLogWithObjects:self.objectEnumerator precision:precision];
+    }
+    return [KQSHyperLogLog hyperLogLogWithArray:self.allValues precision:precision concurrent:YES];
+}
+- (NSUInteger)KQS_approximateDistinctCount; {
+    return [self KQS_hyperLogLogWithPrecision:KQSHyperLogLogDefaultPrecision concurrent:NO].count;
+}
+- (NSDictionary *)KQS_sample:(NSInteger)count; {
+    return [self KQS_sample:count random:nil];
+}
+- (NSDictionary *)KQS_sample:(NSInteger)count random:(KQSRandom *)random; {
+    KQSRandom *generator = random ?: [[KQSRandom alloc] init];
+    NSArray *keys = [generator sampleObjects:self count:(NSUInteger)MAX(count, 0)];
+    
+    return [NSDictionary dictionaryWithObjects:[self objectsForKeys:keys notFoundMarker:[NSNull null]] forKeys:keys];
+}
+- (NSDictionary *)KQS_sampleWeighted:(NSInteger)count block:(double(^)(id key, id value))block; {
+    return [self KQS_sampleWeighted:count random:nil block:block];
+}
+- (NSDictionary *)KQS_sampleWeighted:(NSInteger)count random:(KQSRandom *)random block:(double(^)(id key, id value))block; {
+    NSParameterAssert(block);
+    
+    KQSRandom *generator = random ?: [[KQSRandom alloc] init];
+    NSArray *keys = [generator sampleObjects:self count:(NSUInteger)MAX(count, 0) weight:^double(id key, NSInteger index) {
+        return block(key,[self objectForKey:key]);
+    }];
+    
+    return [NSDictionary dictionaryWithObjects:[self objectsForKeys:keys notFoundMarker:[NSNull null]] forKeys:keys];
+}
 
 @end
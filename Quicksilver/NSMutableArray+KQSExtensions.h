@@ -0,0 +1,41 @@
+//
+//  NSMutableArray+KQSExtensions.h
+//  Quicksilver
+//
+//  Created by William Towe on 10/19/26.
+//  Copyright © 2021 Kosoku Interactive, LLC. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#import <Foundation/Foundation.h>
+
+@class KQSRandom;
+
+NS_ASSUME_NONNULL_BEGIN
+
+@interface NSMutableArray<ObjectType> (KQSExtensions)
+
+/**
+ Calls `[self KQS_shuffleWithRandom:nil]`.
+ */
+- (void)KQS_shuffle;
+/**
+ Shuffles the receiver in place using the Fisher-Yates algorithm, so every order is equally likely. Pass the same seeded *random* to shuffle the same way again.
+ 
+ @param random The generator to use, or nil to use a new randomly seeded one
+ */
+- (void)KQS_shuffleWithRandom:(nullable KQSRandom *)random;
+
+@end
+
+NS_ASSUME_NONNULL_END
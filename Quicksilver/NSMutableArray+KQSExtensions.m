@@ -0,0 +1,36 @@
+//
+//  NSMutableArray+KQSExtensions.m
+//  Quicksilver
+//
+//  Created by William Towe on 10/19/26.
+//  Copyright © 2021 Kosoku Interactive, LLC. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#import "NSMutableArray+KQSExtensions.h"
+#import "KQSRandom.h"
+
+@implementation NSMutableArray (KQSExtensions)
+
+- (void)KQS_shuffle; {
+    [self KQS_shuffleWithRandom:nil];
+}
+- (void)KQS_shuffleWithRandom:(KQSRandom *)random; {
+    KQSRandom *generator = random ?: [[KQSRandom alloc] init];
+    
+    for (NSUInteger i=self.count; i>1; i--) {
+        [self exchangeObjectAtIndex:i - 1 withObjectAtIndex:[generator nextValueBelow:i]];
+    }
+}
+
+@end
@@ -18,6 +18,13 @@
 //  limitations under the License.
 
 #import "NSOrderedSet+KQSExtensions.h"
+#import "NSArray+KQSExtensions.h"
+#import "KQSAsyncTask.h"
+#import "KQSBloomFilter.h"
+#import "KQSHyperLogLog.h"
+#import "KQSRandom.h"
+#import "KQSKeyPathGetter.h"
+#import "KQSSummation.h"
 
 @implementation NSOrderedSet (KQSExtensions)
 
@@ -105,9 +112,15 @@
     return retval;
 }
 - (CGFloat)KQS_reduceFloatWithStart:(CGFloat)start block:(CGFloat(^)(CGFloat sum, id _Nonnull object, NSInteger index))block; {
-    return [[self KQS_reduceWithStart:@(start) block:^id _Nonnull(NSNumber * _Nullable sum, id  _Nonnull object, NSInteger index) {
-        return @(block(sum.floatValue,object,index));
-    }] floatValue];
+    NSParameterAssert(block);
+    
+    __block CGFloat retval = start;
+    
+    [self enumerateObjectsUsingBlock:^(id obj, NSUInteger idx, BOOL *stop) {
+        retval = block(retval,obj,idx);
+    }];
+    
+    return retval;
 }
 - (NSInteger)KQS_reduceIntegerWithStart:(NSInteger)start block:(NSInteger(^)(NSInteger sum, id _Nonnull object, NSInteger index))block; {
     return [[self KQS_reduceWithStart:@(start) block:^id _Nonnull(NSNumber * _Nullable sum, id  _Nonnull object, NSInteger index) {
@@ -227,6 +240,15 @@
     }
     return @0;
 }
+- (id)KQS_sumPrecise; {
+    return @(KQSSummationPrecise(self));
+}
+- (id)KQS_sumPairwise; {
+    return @(KQSSummationPairwise(self.array,NO));
+}
+- (id)KQS_sumPairwiseConcurrently; {
+    return @(KQSSummationPairwise(self.array,YES));
+}
 - (id)KQS_product; {
     if (self.count > 0) {
         NSNumber *first = self.firstObject;
@@ -265,5 +287,155 @@
         return [object compare:sum] == NSOrderedAscending ? object : sum;
     }];
 }
+- (NSOrderedSet *)KQS_pluck:(NSString *)keyPath; {
+    NSParameterAssert(keyPath);
+    
+    KQSKeyPathGetter *getter = [[KQSKeyPathGetter alloc] initWithKeyPath:keyPath];
+    NSMutableOrderedSet *retval = [[NSMutableOrderedSet alloc] initWithCapacity:self.count];
+    
+    for (id object in self) {
+        [retval addObject:[getter valueForObject:object] ?: [NSNull null]];
+    }
+    
+    return [retval copy];
+}
+- (NSOrderedSet *)KQS_filterWhereKeyPath:(NSString *)keyPath equals:(id)value; {
+    NSParameterAssert(keyPath);
+    
+    KQSKeyPathGetter *getter = [[KQSKeyPathGetter alloc] initWithKeyPath:keyPath];
+    NSMutableOrderedSet *retval = [[NSMutableOrderedSet alloc] init];
+    
+    for (id object in self) {
+        if ([getter valueForObject:object isEqual:value]) {
+            [retval addObject:object];
+        }
+    }
+    
+    return [retval copy];
+}
+- (NSOrderedSet *)KQS_sortByKeyPath:(NSString *)keyPath; {
+    return [self KQS_sortByKeyPath:keyPath ascending:YES];
+}
+- (NSOrderedSet *)KQS_sortByKeyPath:(NSString *)keyPath ascending:(BOOL)ascending; {
+    NSParameterAssert(keyPath);
+    
+    NSArray *objects = self.array;
+    
+    return [NSOrderedSet orderedSetWithArray:[[[KQSKeyPathGetter alloc] initWithKeyPath:keyPath] sortObjects:objects bySources:objects ascending:ascending]];
+}
+- (NSNumber *)KQS_sumOfKeyPath:(NSString *)keyPath; {
+    NSParameterAssert(keyPath);
+    
+    return [[[KQSKeyPathGetter alloc] initWithKeyPath:keyPath] sumOfObjects:self];
+}
+- (id)KQS_maximumByKeyPath:(NSString *)keyPath; {
+    NSParameterAssert(keyPath);
+    
+    return [[[KQSKeyPathGetter alloc] initWithKeyPath:keyPath] extremeObjectInObjects:self maximum:YES];
+}
+- (id)KQS_minimumByKeyPath:(NSString *)keyPath; {
+    NSParameterAssert(keyPath);
+    
+    return [[[KQSKeyPathGetter alloc] initWithKeyPath:keyPath] extremeObjectInObjects:self maximum:NO];
+}
+- (NSDictionary *)KQS_groupByKeyPath:(NSString *)keyPath; {
+    NSParameterAssert(keyPath);
+    
+    KQSKeyPathGetter *getter = [[KQSKeyPathGetter alloc] initWithKeyPath:keyPath];
+    NSMutableDictionary *groups = [[NSMutableDictionary alloc] init];
+    
+    for (id object in self) {
+        id key = [getter valueForObject:object] ?: [NSNull null];
+        NSMutableOrderedSet *group = groups[key];
+        
+        if (group == nil) {
+            group = [[NSMutableOrderedSet alloc] init];
+            groups[key] = group;
+        }
+        
+        [group addObject:object];
+    }
+    
+    NSMutableDictionary *retval = [[NSMutableDictionary alloc] initWithCapacity:groups.count];
+    
+    [groups enumerateKeysAndObjectsUsingBlock:^(id  _Nonnull key, NSMutableOrderedSet * _Nonnull obj, BOOL * _Nonnull stop) {
+        retval[key] = [obj copy];
+    }];
+    
+    return [retval copy];
+}
+- (KQSAsyncTask *)KQS_asyncMap:(void(^)(id object, NSInteger index, void(^completion)(id _Nullable value)))block maxConcurrency:(NSInteger)maxConcurrency completion:(void(^)(NSOrderedSet * _Nullable orderedSet, NSError * _Nullable error))completion; {
+    return [self KQS_asyncMap:block maxConcurrency:maxConcurrency timeout:0 queue:nil completion:completion];
+}
+- (KQSAsyncTask *)KQS_asyncMap:(void(^)(id object, NSInteger index, void(^completion)(id _Nullable value)))block maxConcurrency:(NSInteger)maxConcurrency timeout:(NSTimeInterval)timeout queue:(dispatch_queue_t)queue completion:(void(^)(NSOrderedSet * _Nullable orderedSet, NSError * _Nullable error))completion; {
+    NSParameterAssert(block);
+    NSParameterAssert(completion);
+    
+    NSOrderedSet *orderedSet = [self copy];
+    
+    return [KQSAsyncTask taskWithCount:orderedSet.count maxConcurrency:maxConcurrency timeout:timeout queue:queue block:^(NSInteger index, void (^itemCompletion)(id _Nullable)) {
+        block(orderedSet[index],index,itemCompletion);
+    } completion:^(NSArray * _Nullable values, NSError * _Nullable error) {
+        completion(values == nil ? nil : [NSOrderedSet orderedSetWithArray:values],error);
+    }];
+}
+- (KQSAsyncTask *)KQS_asyncFilter:(void(^)(id object, NSInteger index, void(^completion)(BOOL passes)))block maxConcurrency:(NSInteger)maxConcurrency completion:(void(^)(NSOrderedSet * _Nullable orderedSet, NSError * _Nullable error))completion; {
+    return [self KQS_asyncFilter:block maxConcurrency:maxConcurrency timeout:0 queue:nil completion:completion];
+}
+- (KQSAsyncTask *)KQS_asyncFilter:(void(^)(id object, NSInteger index, void(^completion)(BOOL passes)))block maxConcurrency:(NSInteger)maxConcurrency timeout:(NSTimeInterval)timeout queue:(dispatch_queue_t)queue completion:(void(^)(NSOrderedSet * _Nullable orderedSet, NSError * _Nullable error))completion; {
+    NSParameterAssert(block);
+    NSParameterAssert(completion);
+    
+    NSOrderedSet *orderedSet = [self copy];
+    
+    return [KQSAsyncTask taskWithCount:orderedSet.count maxConcurrency:maxConcurrency timeout:timeout queue:queue block:^(NSInteger index, void (^itemCompletion)(id _Nullable)) {
+        block(orderedSet[index],index,^(BOOL passes) {
+            itemCompletion(@(passes));
+        });
+    } completion:^(NSArray * _Nullable values, NSError * _Nullable error) {
+        if (values == nil) {
+            completion(nil,error);
+            return;
+        }
+        
+        NSMutableOrderedSet *retval = [[NSMutableOrderedSet alloc] init];
+        
+        [values enumerateObjectsUsingBlock:^(NSNumber *passes, NSUInteger idx, BOOL *stop) {
+            if (passes.boolValue) {
+                [retval addObject:orderedSet[idx]];
+            }
+        }];
+        
+        completion([retval copy],nil);
+    }];
+}
+- (KQSBloomFilter *)KQS_bloomFilterWithFalsePositiveRate:(double)falsePositiveRate; {
+    return [self KQS_bloomFilterWithFalsePositiveRate:falsePositiveRate concurrent:NO];
+}
+- (KQSBloomFilter *)KQS_bloomFilterWithFalsePositiveRate:(double)falsePositiveRate concurrent:(BOOL)concurrent; {
+    return [KQSBloomFilter bloomFilterWithArray:self.array falsePositiveRate:falsePositiveRate concurrent:concurrent];
+}
+- (KQSHyperLogLog *)KQS_hyperLogLogWithPrecision:(NSUInteger)precision concurrent:(BOOL)concurrent; {
+    return [KQSHyperLogLog hyperLogLogWithArray:self.array precision:precision concurrent:concurrent];
+}
+- (NSUInteger)KQS_approximateDistinctCount; {
+    return [self KQS_hyperLogLogWithPrecision:KQSHyperLogLogDefaultPrecision concurrent:NO].count;
+}
+- (NSOrderedSet *)KQS_sample:(NSInteger)count; {
+    return [self KQS_sample:count random:nil];
+}
+- (NSOrderedSet *)KQS_sample:(NSInteger)count random:(KQSRandom *)random; {
+    return [NSOrderedSet orderedSetWithArray:[self.array KQS_sample:count random:random]];
+}
+- (NSOrderedSet *)KQS_sampleWeighted:(NSInteger)count block:(double(^)(id object, NSInteger index))block; {
+    return [self KQS_sampleWeighted:count random:nil block:block];
+}
+- (NSOrderedSet *)KQS_sampleWeighted:(NSInteger)count random:(KQSRandom *)random block:(double(^)(id object, NSInteger index))block; {
+    NSParameterAssert(block);
+    
+    KQSRandom *generator = random ?: [[KQSRandom alloc] init];
+    
+    return [NSOrderedSet orderedSetWithArray:[generator sampleObjects:self count:(NSUInteger)MAX(count, 0) weight:block]];
+}
 
 @end
@@ -18,6 +18,11 @@
 //  limitations under the License.
 
 #import "NSSet+KQSExtensions.h"
+#import "KQSBloomFilter.h"
+#import "KQSHyperLogLog.h"
+#import "KQSRandom.h"
+#import "KQSKeyPathGetter.h"
+#import "KQSSummation.h"
 
 @implementation NSSet (KQSExtensions)
 
@@ -91,9 +96,15 @@
     return retval;
 }
 - (CGFloat)KQS_reduceFloatWithStart:(CGFloat)start block:(CGFloat(^)(CGFloat sum, id _Nonnull object))block; {
-    return [[self KQS_reduceWithStart:@(start) block:^id _Nonnull(NSNumber * _Nullable sum, id  _Nonnull object) {
-        return @(block(sum.floatValue,object));
-    }] floatValue];
+    NSParameterAssert(block);
+    
+    __block CGFloat retval = start;
+    
+    [self enumerateObjectsUsingBlock:^(id obj, BOOL *stop) {
+        retval = block(retval,obj);
+    }];
+    
+    return retval;
 }
 - (NSInteger)KQS_reduceIntegerWithStart:(NSInteger)start block:(NSInteger(^)(NSInteger sum, id _Nonnull object))block; {
     return [[self KQS_reduceWithStart:@(start) block:^id _Nonnull(NSNumber * _Nullable sum, id  _Nonnull object) {
@@ -184,6 +195,15 @@
     }
     return @0;
 }
+- (id)KQS_sumPrecise; {
+    return @(KQSSummationPrecise(self));
+}
+- (id)KQS_sumPairwise; {
+    return @(KQSSummationPairwise(self.allObjects,NO));
+}
+- (id)KQS_sumPairwiseConcurrently; {
+    return @(KQSSummationPairwise(self.allObjects,YES));
+}
 - (id)KQS_product; {
     if (self.count > 0) {
         NSNumber *first = self.anyObject;
@@ -222,5 +242,121 @@
         return [object compare:sum] == NSOrderedAscending ? object : sum;
     }];
 }
+- (NSSet *)KQS_pluck:(NSString *)keyPath; {
+    NSParameterAssert(keyPath);
+    
+    KQSKeyPathGetter *getter = [[KQSKeyPathGetter alloc] initWithKeyPath:keyPath];
+    NSMutableSet *retval = [[NSMutableSet alloc] initWithCapacity:self.count];
+    
+    for (id object in self) {
+        [retval addObject:[getter valueForObject:object] ?: [NSNull null]];
+    }
+    
+    return [retval copy];
+}
+- (NSSet *)KQS_filterWhereKeyPath:(NSString *)keyPath equals:(id)value; {
+    NSParameterAssert(keyPath);
+    
+    KQSKeyPathGetter *getter = [[KQSKeyPathGetter alloc] initWithKeyPath:keyPath];
+    NSMutableSet *retval = [[NSMutableSet alloc] init];
+    
+    for (id object in self) {
+        if ([getter valueForObject:object isEqual:value]) {
+            [retval addObject:object];
+        }
+    }
+    
+    return [retval copy];
+}
+- (NSArray *)KQS_sortByKeyPath:(NSString *)keyPath; {
+    return [self KQS_sortByKeyPath:keyPath ascending:YES];
+}
+- (NSArray *)KQS_sortByKeyPath:(NSString *)keyPath ascending:(BOOL)ascending; {
+    NSParameterAssert(keyPath);
+    
+    NSArray *objects = self.allObjects;
+    
+    return [[[KQSKeyPathGetter alloc] initWithKeyPath:keyPath] sortObjects:objects bySources:objects ascending:ascending];
+}
+- (NSNumber *)KQS_sumOfKeyPath:(NSString *)keyPath; {
+    NSParameterAssert(keyPath);
+    
+    return [[[KQSKeyPathGetter alloc] initWithKeyPath:keyPath] sumOfObjects:self];
+}
+- (id)KQS_maximumByKeyPath:(NSString *)keyPath; {
+    NSParameterAssert(keyPath);
+    
+    return [[[KQSKeyPathGetter alloc] initWithKeyPath:keyPath] extremeObjectInObjects:self maximum:YES];
+}
+- (id)KQS_minimumByKeyPath:(NSString *)keyPath; {
+    NSParameterAssert(keyPath);
+    
+    return [[[KQSKeyPathGetter alloc] initWithKeyPath:keyPath] extremeObjectInObjects:self maximum:NO];
+}
+- (NSDictionary *)KQS_groupByKeyPath:(NSString *)keyPath; {
+    NSParameterAssert(keyPath);
+    
+    KQSKeyPathGetter *getter = [[KQSKeyPathGetter alloc] initWithKeyPath:keyPath];
+    NSMutableDictionary *groups = [[NSMutableDictionary alloc] init];
+    
+    for (id object in self) {
+        id key = [getter valueForObject:object] ?: [NSNull null];
+        NSMutableSet *group = groups[key];
+        
+        if (group == nil) {
+            group = [[NSMutableSet alloc] init];
+            groups[key] = group;
+        }
+        
+        [group addObject:object];
+    }
+    
+    NSMutableDictionary *retval = [[NSMutableDictionary alloc] initWithCapacity:groups.count];
+    
+    [groups enumerateKeysAndObjectsUsingBlock:^(id  _Nonnull key, NSMutableSet * _Nonnull obj, BOOL * _Nonnull stop) {
+        retval[key] = [obj copy];
+    }];
+    
+    return [retval copy];
+}
+- (KQSBloomFilter *)KQS_bloomFilterWithFalsePositiveRate:(double)falsePositiveRate; {
+    return [self KQS_bloomFilterWithFalsePositiveRate:falsePositiveRate concurrent:NO];
+}
+- (KQSBloomFilter *)KQS_bloomFilterWithFalsePositiveRate:(double)falsePositiveRate concurrent:(BOOL)concurrent; {
+    // only the concurrent build needs the objects by index, the serial build hashes them in place
+    if (!concurrent) {
+        return [KQSBloomFilter bloomFilterWithObjects:self capacity:self.count falsePositiveRate:falsePositiveRate];
+    }
+    return [KQSBloomFilter bloomFilterWithArray:self.allObjects falsePositiveRate:falsePositiveRate concurrent:YES];
+}
+- (KQSHyperLogLog *)KQS_hyperLogLogWithPrecision:(NSUInteger)precision concurrent:(BOOL)concurrent; {
+    if (!concurrent) {
+        return [KQSHyperLogLog hyperLogLogWithObjects:self precision:precision];
+    }
+    return [KQSHyperLogLog hyperLogLogWithArray:self.allObjects precision:precision concurrent:YES];
+}
+- (NSUInteger)KQS_approximateDistinctCount; {
+    return [self KQS_hyperLogLogWithPrecision:KQSHyperLogLogDefaultPrecision concurrent:NO].count;
+}
+- (NSSet *)KQS_sample:(NSInteger)count; {
+    return [self KQS_sample:count random:nil];
+}
+- (NSSet *)KQS_sample:(NSInteger)count random:(KQSRandom *)random; {
+    KQSRandom *generator = random ?: [[KQSRandom alloc] init];
+    
+    return [NSSet setWithArray:[generator sampleObjects:self count:(NSUInteger)MAX(count, 0)]];
+}
+- (NSSet *)KQS_sampleWeighted:(NSInteger)count block:(double(^)(id object))block; {
+    return [self KQS_sampleWeighted:count random:nil block:block];
+}
+- (NSSet *)KQS_sampleWeighted:(NSInteger)count random:(KQSRandom *)random block:(double(^)(id object))block; {
+    NSParameterAssert(block);
+    
+    KQSRandom *generator = random ?: [[KQSRandom alloc] init];
+    
+    return [NSSet setWithArray:[generator sampleObjects:self count:(NSUInteger)MAX(count, 0) weight:^double(id object, NSInteger index) {
+        return block(object);
+    }]];
+}
 
 @end
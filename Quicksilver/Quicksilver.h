@@ -29,6 +29,13 @@ FOUNDATION_EXPORT const unsigned char QuicksilverVersionString[];
 
 #import <Quicksilver/NSArray+KQSExtensions.h>
 #import <Quicksilver/NSDictionary+KQSExtensions.h>
+#import <Quicksilver/NSMutableArray+KQSExtensions.h>
 #import <Quicksilver/NSOrderedSet+KQSExtensions.h>
 #import <Quicksilver/NSSet+KQSExtensions.h>
 #import <Quicksilver/NSString+KQSExtensions.h>
+#import <Quicksilver/KQSPersistentVector.h>
+#import <Quicksilver/KQSAsyncTask.h>
+#import <Quicksilver/KQSBloomFilter.h>
+#import <Quicksilver/KQSHyperLogLog.h>
+#import <Quicksilver/KQSRandom.h>
+#import <Quicksilver/KQSCpp.h>
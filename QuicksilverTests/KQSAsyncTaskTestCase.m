@@ -0,0 +1,127 @@
+//
+//  KQSAsyncTaskTestCase.m
+//  QuicksilverTests-iOS
+//
+//  Created by William Towe on 10/19/26.
+//  Copyright © 2021 Kosoku Interactive, LLC. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#import <XCTest/XCTest.h>
+
+#import <Quicksilver/KQSAsyncTask.h>
+
+@interface KQSAsyncTaskTestCase : XCTestCase
+
+@end
+
+@implementation KQSAsyncTaskTestCase
+
+- (void)testOrderedResults {
+    XCTestExpectation *expectation = [self expectationWithDescription:@"complete"];
+    NSMutableArray *end = [[NSMutableArray alloc] init];
+
+    for (NSInteger i=0; i<100; i++) {
+        [end addObject:@(i * 2)];
+    }
+
+    [KQSAsyncTask taskWithCount:end.count maxConcurrency:8 timeout:0 queue:nil block:^(NSInteger index, void (^completion)(id _Nullable)) {
+        // complete later items sooner so results arrive out of order
+        dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)((100 - index) * NSEC_PER_USEC * 50)), dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+            completion(@(index * 2));
+        });
+    } completion:^(NSArray * _Nullable values, NSError * _Nullable error) {
+        XCTAssertNil(error);
+        XCTAssertEqualObjects(values, end);
+        [expectation fulfill];
+    }];
+
+    [self waitForExpectationsWithTimeout:5.0 handler:nil];
+}
+- (void)testMaxConcurrency {
+    XCTestExpectation *expectation = [self expectationWithDescription:@"complete"];
+    NSInteger maxConcurrency = 3;
+    __block NSInteger inFlight = 0, maxInFlight = 0;
+    NSObject *lock = [[NSObject alloc] init];
+
+    [KQSAsyncTask taskWithCount:30 maxConcurrency:maxConcurrency timeout:0 queue:nil block:^(NSInteger index, void (^completion)(id _Nullable)) {
+        @synchronized(lock) {
+            inFlight++;
+            maxInFlight = MAX(inFlight, maxInFlight);
+        }
+
+        dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(NSEC_PER_MSEC * 2)), dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+            @synchronized(lock) {
+                inFlight--;
+            }
+            completion(nil);
+        });
+    } completion:^(NSArray * _Nullable values, NSError * _Nullable error) {
+        XCTAssertEqual(values.count, 30);
+        XCTAssertEqualObjects(values.firstObject, [NSNull null]);
+        [expectation fulfill];
+    }];
+
+    [self waitForExpectationsWithTimeout:5.0 handler:nil];
+
+    XCTAssertLessThanOrEqual(maxInFlight, maxConcurrency);
+}
+- (void)testEmpty {
+    XCTestExpectation *expectation = [self expectationWithDescription:@"complete"];
+
+    [KQSAsyncTask taskWithCount:0 maxConcurrency:0 timeout:0 queue:nil block:^(NSInteger index, void (^completion)(id _Nullable)) {
+        XCTFail(@"block should not be invoked");
+    } completion:^(NSArray * _Nullable values, NSError * _Nullable error) {
+        XCTAssertEqualObjects(values, @[]);
+        [expectation fulfill];
+    }];
+
+    [self waitForExpectationsWithTimeout:5.0 handler:nil];
+}
+- (void)testCancel {
+    XCTestExpectation *expectation = [self expectationWithDescription:@"complete"];
+
+    KQSAsyncTask *task = [KQSAsyncTask taskWithCount:10 maxConcurrency:1 timeout:0 queue:nil block:^(NSInteger index, void (^completion)(id _Nullable)) {
+        // never completes
+    } completion:^(NSArray * _Nullable values, NSError * _Nullable error) {
+        XCTAssertNil(values);
+        XCTAssertEqualObjects(error.domain, KQSAsyncTaskErrorDomain);
+        XCTAssertEqual(error.code, KQSAsyncTaskErrorCodeCancelled);
+        [expectation fulfill];
+    }];
+
+    [task cancel];
+
+    [self waitForExpectationsWithTimeout:5.0 handler:nil];
+
+    XCTAssertTrue(task.isCancelled);
+    XCTAssertTrue(task.isFinished);
+}
+- (void)testTimeout {
+    XCTestExpectation *expectation = [self expectationWithDescription:@"complete"];
+
+    [KQSAsyncTask taskWithCount:3 maxConcurrency:3 timeout:0.1 queue:nil block:^(NSInteger index, void (^completion)(id _Nullable)) {
+        if (index != 1) {
+            completion(@(index));
+        }
+    } completion:^(NSArray * _Nullable values, NSError * _Nullable error) {
+        XCTAssertNil(values);
+        XCTAssertEqual(error.code, KQSAsyncTaskErrorCodeTimedOut);
+        XCTAssertEqualObjects(error.userInfo[KQSAsyncTaskErrorIndexKey], @1);
+        [expectation fulfill];
+    }];
+
+    [self waitForExpectationsWithTimeout:5.0 handler:nil];
+}
+
+@end
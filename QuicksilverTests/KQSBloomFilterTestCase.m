@@ -0,0 +1,102 @@
+//
+//  KQSBloomFilterTestCase.m
+//  QuicksilverTests-iOS
+//
+//  Created by William Towe on 10/19/26.
+//  Copyright © 2021 Kosoku Interactive, LLC. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#import <XCTest/XCTest.h>
+
+#import <Quicksilver/Quicksilver.h>
+
+@interface KQSBloomFilterTestCase : XCTestCase
+
+@end
+
+@implementation KQSBloomFilterTestCase
+
+- (void)testContainsObject {
+    KQSBloomFilter *filter = [[KQSBloomFilter alloc] initWithCapacity:1000 falsePositiveRate:0.01];
+    
+    for (NSInteger i=0; i<1000; i++) {
+        [filter addObject:@(i)];
+    }
+    for (NSInteger i=0; i<1000; i++) {
+        XCTAssertTrue([filter containsObject:@(i)]);
+    }
+    
+    NSInteger falsePositives = 0;
+    
+    for (NSInteger i=1000; i<11000; i++) {
+        if ([filter containsObject:@(i)]) {
+            falsePositives++;
+        }
+    }
+    
+    XCTAssertLessThan(falsePositives, 300);
+}
+- (void)testSizing {
+    KQSBloomFilter *filter = [[KQSBloomFilter alloc] initWithCapacity:1000 falsePositiveRate:0.01];
+    
+    XCTAssertEqual(filter.numberOfBits % 64, 0);
+    XCTAssertGreaterThanOrEqual(filter.numberOfBits, 9585);
+    XCTAssertEqual(filter.numberOfHashFunctions, 7);
+    XCTAssertFalse([filter containsObject:@"a"]);
+}
+- (void)testUnion {
+    KQSBloomFilter *first = [[KQSBloomFilter alloc] initWithCapacity:100 falsePositiveRate:0.01];
+    KQSBloomFilter *second = [[KQSBloomFilter alloc] initWithCapacity:100 falsePositiveRate:0.01];
+    
+    [first addObject:@"a"];
+    [second addObject:@"b"];
+    
+    KQSBloomFilter *copy = [first copy];
+    
+    [first unionBloomFilter:second];
+    
+    XCTAssertTrue([first containsObject:@"a"]);
+    XCTAssertTrue([first containsObject:@"b"]);
+    XCTAssertTrue([copy containsObject:@"a"]);
+    
+    XCTAssertThrows([first unionBloomFilter:[[KQSBloomFilter alloc] initWithCapacity:10000 falsePositiveRate:0.01]]);
+}
+- (void)testConcurrent {
+    NSMutableArray *begin = [[NSMutableArray alloc] init];
+    
+    for (NSInteger i=0; i<100000; i++) {
+        [begin addObject:[NSString stringWithFormat:@"%@",@(i)]];
+    }
+    
+    KQSBloomFilter *serial = [begin KQS_bloomFilterWithFalsePositiveRate:0.01];
+    KQSBloomFilter *concurrent = [begin KQS_bloomFilterWithFalsePositiveRate:0.01 concurrent:YES];
+    
+    for (NSString *object in begin) {
+        XCTAssertTrue([concurrent containsObject:object]);
+    }
+    for (NSInteger i=100000; i<110000; i++) {
+        NSString *object = [NSString stringWithFormat:@"%@",@(i)];
+        
+        XCTAssertEqual([serial containsObject:object], [concurrent containsObject:object]);
+    }
+}
+- (void)testCollections {
+    XCTAssertTrue([[[NSSet setWithArray:@[@1,@2,@3]] KQS_bloomFilterWithFalsePositiveRate:0.01] containsObject:@2]);
+    XCTAssertTrue([[[NSOrderedSet orderedSetWithArray:@[@1,@2,@3]] KQS_bloomFilterWithFalsePositiveRate:0.01] containsObject:@3]);
+    XCTAssertTrue([[@{@"a": @1, @"b": @2} KQS_bloomFilterWithFalsePositiveRate:0.01] containsObject:@2]);
+    XCTAssertTrue([[KQSBloomFilter bloomFilterWithObjects:@[@1,@2,@3].objectEnumerator capacity:3 falsePositiveRate:0.01] containsObject:@1]);
+    XCTAssertFalse([[@[] KQS_bloomFilterWithFalsePositiveRate:0.01] containsObject:@1]);
+}
+
+@end
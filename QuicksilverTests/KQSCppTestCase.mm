@@ -0,0 +1,88 @@
+//
+//  KQSCppTestCase.mm
+//  QuicksilverTests-iOS
+//
+//  Created by William Towe on 10/19/26.
+//  Copyright © 2021 Kosoku Interactive, LLC. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#import <XCTest/XCTest.h>
+
+#import <Quicksilver/Quicksilver.h>
+
+@interface KQSCppTestCase : XCTestCase
+
+@end
+
+@implementation KQSCppTestCase
+
+- (void)testArray {
+    NSArray *begin = @[@"a",@"bb",@"ccc",@"dddd"];
+    
+    XCTAssertEqualObjects(kqs::filter<NSString *>(begin, [](NSString *object, NSInteger index){ return object.length > 2; }), [begin KQS_filter:^BOOL(NSString *object, NSInteger index) {
+        return object.length > 2;
+    }]);
+    XCTAssertEqualObjects(kqs::reject(begin, [](id object, NSInteger index){ return index % 2 == 0; }), (@[@"bb",@"dddd"]));
+    XCTAssertEqualObjects(kqs::find<NSString *>(begin, [](NSString *object, NSInteger index){ return [object hasPrefix:@"c"]; }), @"ccc");
+    XCTAssertNil(kqs::find(begin, [](id object, NSInteger index){ return false; }));
+    XCTAssertEqualObjects(kqs::map<NSString *>(begin, [](NSString *object, NSInteger index) -> id { return index == 1 ? nil : object.uppercaseString; }), (@[@"A",[NSNull null],@"CCC",@"DDDD"]));
+    XCTAssertTrue(kqs::any<NSString *>(begin, [](NSString *object, NSInteger index){ return object.length == 4; }));
+    XCTAssertTrue(kqs::all<NSString *>(begin, [](NSString *object, NSInteger index){ return object.length > 0; }));
+    XCTAssertTrue(kqs::none<NSString *>(begin, [](NSString *object, NSInteger index){ return object.length > 4; }));
+    
+    std::vector<NSUInteger> lengths = kqs::map_vector<NSString *>(begin, [](NSString *object, NSInteger index){ return object.length; });
+    
+    XCTAssertEqual(lengths.size(), (size_t)4);
+    XCTAssertEqual(lengths[3], (NSUInteger)4);
+    
+    NSInteger count = 0;
+    
+    kqs::each(begin, [&](id object, NSInteger index){ count += index; });
+    
+    XCTAssertEqual(count, 6);
+}
+- (void)testUnboxing {
+    NSArray *begin = @[@1,@2.5,@3];
+    
+    XCTAssertEqualWithAccuracy(kqs::reduce<double>(begin, 0.0, [](double sum, double value, NSInteger index){ return sum + value; }), 6.5, 0.0001);
+    XCTAssertEqual(kqs::reduce<NSInteger>(begin, (NSInteger)0, [](NSInteger sum, NSInteger value, NSInteger index){ return sum + value; }), 6);
+    XCTAssertEqual(kqs::filter<int>(begin, [](int value, NSInteger index){ return value > 1; }).count, 2);
+}
+- (void)testOrderedSet {
+    NSOrderedSet *begin = [NSOrderedSet orderedSetWithArray:@[@1,@2,@3,@4]];
+    
+    XCTAssertEqualObjects(kqs::filter<NSNumber *>(begin, [](NSNumber *object, NSInteger index){ return object.integerValue % 2 == 0; }), [NSOrderedSet orderedSetWithArray:@[@2,@4]]);
+    XCTAssertEqualObjects(kqs::map<NSInteger>(begin, [](NSInteger value, NSInteger index) -> id { return @(value * 2); }), [NSOrderedSet orderedSetWithArray:@[@2,@4,@6,@8]]);
+    XCTAssertEqual(kqs::reduce<NSInteger>(begin, (NSInteger)0, [](NSInteger sum, NSInteger value, NSInteger index){ return sum + value; }), 10);
+    XCTAssertFalse(kqs::all<NSInteger>(begin, [](NSInteger value, NSInteger index){ return value < 4; }));
+}
+- (void)testSet {
+    NSSet *begin = [NSSet setWithArray:@[@1,@2,@3,@4]];
+    
+    XCTAssertEqualObjects(kqs::reject<NSInteger>(begin, [](NSInteger value){ return value > 2; }), ([NSSet setWithArray:@[@1,@2]]));
+    XCTAssertEqualObjects(kqs::map<NSNumber *>(begin, [](NSNumber *object) -> id { return object.stringValue; }), ([NSSet setWithArray:@[@"1",@"2",@"3",@"4"]]));
+    XCTAssertEqual(kqs::reduce<NSInteger>(begin, (NSInteger)0, [](NSInteger sum, NSInteger value){ return sum + value; }), 10);
+    XCTAssertTrue(kqs::any<NSInteger>(begin, [](NSInteger value){ return value == 3; }));
+}
+- (void)testDictionary {
+    NSDictionary *begin = @{@"a": @1, @"b": @2, @"c": @3};
+    
+    XCTAssertEqualObjects((kqs::filter<NSString *, NSInteger>(begin, [](NSString *key, NSInteger value){ return value > 1; })), (@{@"b": @2, @"c": @3}));
+    XCTAssertEqualObjects((kqs::map<id, NSInteger>(begin, [](id key, NSInteger value) -> id { return @(value * 10); })), (@{@"a": @10, @"b": @20, @"c": @30}));
+    XCTAssertEqualObjects(kqs::find<NSString *>(begin, [](NSString *key, id value){ return [key isEqualToString:@"b"]; }), @2);
+    XCTAssertEqual((kqs::reduce<id, NSInteger>(begin, (NSInteger)0, [](NSInteger sum, id key, NSInteger value){ return sum + value; })), 6);
+    XCTAssertTrue(kqs::none(@{}, [](id key, id value){ return true; }));
+}
+
+@end
@@ -0,0 +1,474 @@
+//
+//  KQSDifferentialHarness+KQSCpp.mm
+//  QuicksilverTests-iOS
+//
+//  Created by William Towe on 10/19/26.
+//  Copyright © 2021 Kosoku Interactive, LLC. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#import "KQSDifferentialHarnessPrivate.h"
+
+#import <Quicksilver/Quicksilver.h>
+
+#include <vector>
+
+// boxes the result of map_vector so it can be compared with the reference
+template<typename T>
+static NSArray *KQSDifferentialHarnessBoxVector(std::vector<T> const &vector) {
+    NSMutableArray *retval = [[NSMutableArray alloc] initWithCapacity:vector.size()];
+
+    for (T const &value : vector) {
+        [retval addObject:@(value)];
+    }
+
+    return retval;
+}
+
+@implementation KQSDifferentialHarness (KQSCpp)
+
+- (void)checkCpp {
+    NSArray *array = [self randomArrayWithCount:[self randomCount] depth:1];
+    NSOrderedSet *orderedSet = [NSOrderedSet orderedSetWithArray:array];
+    NSSet *set = [NSSet setWithArray:array];
+    NSDictionary *dictionary = [self randomDictionaryWithCount:[self randomCount] depth:1];
+    NSArray<NSNumber *> *doubles = [self randomDoublesWithCount:[self randomCount]];
+    // passes for roughly one object in divisor, as in checkFindAndPredicates
+    NSUInteger salt = (NSUInteger)[self nextRandom];
+    NSUInteger divisor = 1 + [self randomBelow:32];
+    auto indexed = [=](id object, NSInteger index) {
+        return (([object hash] ^ salt) + (NSUInteger)index) % divisor == 0;
+    };
+    auto unindexed = [=](id object) {
+        return ([object hash] ^ salt) % divisor == 0;
+    };
+    auto pairs = [=](id key, id value) {
+        return ([key hash] ^ [value hash] ^ salt) % divisor == 0;
+    };
+    // the enumeration order of sets and dictionaries is unspecified, so any match is accepted
+    KQSDifferentialHarnessEqualBlock anyMatch = ^BOOL(id expected, id actual) {
+        return [expected count] == 0 ? actual == nil : [expected containsObject:actual];
+    };
+
+    [self checkOperation:@"kqs::filter(NSArray)" input:array reference:^id{
+        NSMutableArray *retval = [[NSMutableArray alloc] init];
+
+        for (NSUInteger i=0; i<array.count; i++) {
+            if (indexed(array[i],i)) {
+                [retval addObject:array[i]];
+            }
+        }
+        return retval;
+    } optimised:^id{
+        return kqs::filter(array, indexed);
+    }];
+    [self checkOperation:@"kqs::reject(NSArray)" input:array reference:^id{
+        NSMutableArray *retval = [[NSMutableArray alloc] init];
+
+        for (NSUInteger i=0; i<array.count; i++) {
+            if (!indexed(array[i],i)) {
+                [retval addObject:array[i]];
+            }
+        }
+        return retval;
+    } optimised:^id{
+        return kqs::reject(array, indexed);
+    }];
+    [self checkOperation:@"kqs::find(NSArray)" input:array reference:^id{
+        for (NSUInteger i=0; i<array.count; i++) {
+            if (indexed(array[i],i)) {
+                return array[i];
+            }
+        }
+        return nil;
+    } optimised:^id{
+        return kqs::find(array, indexed);
+    }];
+    [self checkOperation:@"kqs::any(NSArray)" input:array reference:^id{
+        for (NSUInteger i=0; i<array.count; i++) {
+            if (indexed(array[i],i)) {
+                return @YES;
+            }
+        }
+        return @NO;
+    } optimised:^id{
+        return @(kqs::any(array, indexed));
+    }];
+    [self checkOperation:@"kqs::all(NSArray)" input:array reference:^id{
+        for (NSUInteger i=0; i<array.count; i++) {
+            if (indexed(array[i],i)) {
+                return @NO;
+            }
+        }
+        return @YES;
+    } optimised:^id{
+        return @(kqs::all(array, [&](id object, NSInteger index){ return !indexed(object, index); }));
+    }];
+    [self checkOperation:@"kqs::none(NSArray)" input:array reference:^id{
+        for (NSUInteger i=0; i<array.count; i++) {
+            if (indexed(array[i],i)) {
+                return @NO;
+            }
+        }
+        return @YES;
+    } optimised:^id{
+        return @(kqs::none(array, indexed));
+    }];
+    [self checkOperation:@"kqs::map(NSArray)" input:array reference:^id{
+        NSMutableArray *retval = [[NSMutableArray alloc] init];
+
+        for (NSUInteger i=0; i<array.count; i++) {
+            [retval addObject:indexed(array[i],i) ? [NSNull null] : @[array[i],@(i)]];
+        }
+        return retval;
+    } optimised:^id{
+        return kqs::map(array, [&](id object, NSInteger index) -> id { return indexed(object, index) ? nil : @[object,@(index)]; });
+    }];
+    [self checkOperation:@"kqs::map_vector(NSArray)" input:array reference:^id{
+        NSMutableArray *retval = [[NSMutableArray alloc] init];
+
+        for (NSUInteger i=0; i<array.count; i++) {
+            [retval addObject:@([array[i] hash] ^ (NSUInteger)i)];
+        }
+        return retval;
+    } optimised:^id{
+        return KQSDifferentialHarnessBoxVector(kqs::map_vector(array, [](id object, NSInteger index){ return [object hash] ^ (NSUInteger)index; }));
+    }];
+    [self checkOperation:@"kqs::each(NSArray)" input:array reference:^id{
+        NSMutableArray *retval = [[NSMutableArray alloc] init];
+
+        for (NSUInteger i=0; i<array.count; i++) {
+            [retval addObject:@[array[i],@(i)]];
+        }
+        return retval;
+    } optimised:^id{
+        NSMutableArray *retval = [[NSMutableArray alloc] init];
+
+        kqs::each(array, [&](id object, NSInteger index){ [retval addObject:@[object,@(index)]]; });
+
+        return retval;
+    }];
+    // the same order of additions as the reference, so the sums are identical
+    [self checkOperation:@"kqs::reduce<double>(NSArray)" input:doubles reference:^id{
+        double retval = 0.0;
+
+        for (NSNumber *number in doubles) {
+            retval += number.doubleValue;
+        }
+        return @(retval);
+    } optimised:^id{
+        return @(kqs::reduce<double>(doubles, 0.0, [](double sum, double value, NSInteger index){ return sum + value; }));
+    }];
+
+    [self checkOperation:@"kqs::filter(NSOrderedSet)" input:orderedSet reference:^id{
+        NSMutableOrderedSet *retval = [[NSMutableOrderedSet alloc] init];
+
+        for (NSUInteger i=0; i<orderedSet.count; i++) {
+            if (indexed(orderedSet[i],i)) {
+                [retval addObject:orderedSet[i]];
+            }
+        }
+        return retval;
+    } optimised:^id{
+        return kqs::filter(orderedSet, indexed);
+    }];
+    [self checkOperation:@"kqs::reject(NSOrderedSet)" input:orderedSet reference:^id{
+        NSMutableOrderedSet *retval = [[NSMutableOrderedSet alloc] init];
+
+        for (NSUInteger i=0; i<orderedSet.count; i++) {
+            if (!indexed(orderedSet[i],i)) {
+                [retval addObject:orderedSet[i]];
+            }
+        }
+        return retval;
+    } optimised:^id{
+        return kqs::reject(orderedSet, indexed);
+    }];
+    [self checkOperation:@"kqs::find(NSOrderedSet)" input:orderedSet reference:^id{
+        for (NSUInteger i=0; i<orderedSet.count; i++) {
+            if (indexed(orderedSet[i],i)) {
+                return orderedSet[i];
+            }
+        }
+        return nil;
+    } optimised:^id{
+        return kqs::find(orderedSet, indexed);
+    }];
+    [self checkOperation:@"kqs::any(NSOrderedSet)" input:orderedSet reference:^id{
+        for (NSUInteger i=0; i<orderedSet.count; i++) {
+            if (indexed(orderedSet[i],i)) {
+                return @YES;
+            }
+        }
+        return @NO;
+    } optimised:^id{
+        return @(kqs::any(orderedSet, indexed));
+    }];
+    [self checkOperation:@"kqs::all(NSOrderedSet)" input:orderedSet reference:^id{
+        for (NSUInteger i=0; i<orderedSet.count; i++) {
+            if (indexed(orderedSet[i],i)) {
+                return @NO;
+            }
+        }
+        return @YES;
+    } optimised:^id{
+        return @(kqs::all(orderedSet, [&](id object, NSInteger index){ return !indexed(object, index); }));
+    }];
+    [self checkOperation:@"kqs::none(NSOrderedSet)" input:orderedSet reference:^id{
+        for (NSUInteger i=0; i<orderedSet.count; i++) {
+            if (indexed(orderedSet[i],i)) {
+                return @NO;
+            }
+        }
+        return @YES;
+    } optimised:^id{
+        return @(kqs::none(orderedSet, indexed));
+    }];
+    [self checkOperation:@"kqs::map(NSOrderedSet)" input:orderedSet reference:^id{
+        NSMutableOrderedSet *retval = [[NSMutableOrderedSet alloc] init];
+
+        for (NSUInteger i=0; i<orderedSet.count; i++) {
+            [retval addObject:indexed(orderedSet[i],i) ? [NSNull null] : @[orderedSet[i],@(i)]];
+        }
+        return retval;
+    } optimised:^id{
+        return kqs::map(orderedSet, [&](id object, NSInteger index) -> id { return indexed(object, index) ? nil : @[object,@(index)]; });
+    }];
+    [self checkOperation:@"kqs::map_vector(NSOrderedSet)" input:orderedSet reference:^id{
+        NSMutableArray *retval = [[NSMutableArray alloc] init];
+
+        for (NSUInteger i=0; i<orderedSet.count; i++) {
+            [retval addObject:@([orderedSet[i] hash] ^ (NSUInteger)i)];
+        }
+        return retval;
+    } optimised:^id{
+        return KQSDifferentialHarnessBoxVector(kqs::map_vector(orderedSet, [](id object, NSInteger index){ return [object hash] ^ (NSUInteger)index; }));
+    }];
+    [self checkOperation:@"kqs::reduce(NSOrderedSet)" input:orderedSet reference:^id{
+        NSUInteger retval = 0;
+
+        for (NSUInteger i=0; i<orderedSet.count; i++) {
+            retval = retval * 31 + ([orderedSet[i] hash] ^ (NSUInteger)i);
+        }
+        return @(retval);
+    } optimised:^id{
+        return @(kqs::reduce(orderedSet, (NSUInteger)0, [](NSUInteger retval, id object, NSInteger index){ return retval * 31 + ([object hash] ^ (NSUInteger)index); }));
+    }];
+
+    [self checkOperation:@"kqs::filter(NSSet)" input:set reference:^id{
+        NSMutableSet *retval = [[NSMutableSet alloc] init];
+
+        for (id object in set) {
+            if (unindexed(object)) {
+                [retval addObject:object];
+            }
+        }
+        return retval;
+    } optimised:^id{
+        return kqs::filter(set, unindexed);
+    }];
+    [self checkOperation:@"kqs::reject(NSSet)" input:set reference:^id{
+        NSMutableSet *retval = [[NSMutableSet alloc] init];
+
+        for (id object in set) {
+            if (!unindexed(object)) {
+                [retval addObject:object];
+            }
+        }
+        return retval;
+    } optimised:^id{
+        return kqs::reject(set, unindexed);
+    }];
+    [self checkOperation:@"kqs::find(NSSet)" input:set reference:^id{
+        NSMutableArray *retval = [[NSMutableArray alloc] init];
+
+        for (id object in set) {
+            if (unindexed(object)) {
+                [retval addObject:object];
+            }
+        }
+        return retval;
+    } optimised:^id{
+        return kqs::find(set, unindexed);
+    } equal:anyMatch];
+    [self checkOperation:@"kqs::any(NSSet)" input:set reference:^id{
+        for (id object in set) {
+            if (unindexed(object)) {
+                return @YES;
+            }
+        }
+        return @NO;
+    } optimised:^id{
+        return @(kqs::any(set, unindexed));
+    }];
+    [self checkOperation:@"kqs::all(NSSet)" input:set reference:^id{
+        for (id object in set) {
+            if (unindexed(object)) {
+                return @NO;
+            }
+        }
+        return @YES;
+    } optimised:^id{
+        return @(kqs::all(set, [&](id object){ return !unindexed(object); }));
+    }];
+    [self checkOperation:@"kqs::none(NSSet)" input:set reference:^id{
+        for (id object in set) {
+            if (unindexed(object)) {
+                return @NO;
+            }
+        }
+        return @YES;
+    } optimised:^id{
+        return @(kqs::none(set, unindexed));
+    }];
+    [self checkOperation:@"kqs::map(NSSet)" input:set reference:^id{
+        NSMutableSet *retval = [[NSMutableSet alloc] init];
+
+        for (id object in set) {
+            [retval addObject:unindexed(object) ? [NSNull null] : @[object]];
+        }
+        return retval;
+    } optimised:^id{
+        return kqs::map(set, [&](id object) -> id { return unindexed(object) ? nil : @[object]; });
+    }];
+    // map_vector follows the enumeration order of the set, which is the same for the reference as long as the set is not mutated
+    [self checkOperation:@"kqs::map_vector(NSSet)" input:set reference:^id{
+        NSMutableArray *retval = [[NSMutableArray alloc] init];
+
+        for (id object in set) {
+            [retval addObject:@([object hash] ^ salt)];
+        }
+        return retval;
+    } optimised:^id{
+        return KQSDifferentialHarnessBoxVector(kqs::map_vector(set, [=](id object){ return [object hash] ^ salt; }));
+    }];
+    // wrapping addition is commutative, so the enumeration order does not matter
+    [self checkOperation:@"kqs::reduce(NSSet)" input:set reference:^id{
+        NSUInteger retval = 0;
+
+        for (id object in set) {
+            retval += [object hash] ^ salt;
+        }
+        return @(retval);
+    } optimised:^id{
+        return @(kqs::reduce(set, (NSUInteger)0, [=](NSUInteger retval, id object){ return retval + ([object hash] ^ salt); }));
+    }];
+    [self checkOperation:@"kqs::each(NSSet)" input:set reference:^id{
+        return set;
+    } optimised:^id{
+        NSMutableSet *retval = [[NSMutableSet alloc] init];
+
+        kqs::each(set, [&](id object){ [retval addObject:object]; });
+
+        return retval;
+    }];
+
+    [self checkOperation:@"kqs::filter(NSDictionary)" input:dictionary reference:^id{
+        NSMutableDictionary *retval = [[NSMutableDictionary alloc] init];
+
+        for (id key in dictionary) {
+            if (pairs(key,dictionary[key])) {
+                retval[key] = dictionary[key];
+            }
+        }
+        return retval;
+    } optimised:^id{
+        return kqs::filter(dictionary, pairs);
+    }];
+    [self checkOperation:@"kqs::reject(NSDictionary)" input:dictionary reference:^id{
+        NSMutableDictionary *retval = [[NSMutableDictionary alloc] init];
+
+        for (id key in dictionary) {
+            if (!pairs(key,dictionary[key])) {
+                retval[key] = dictionary[key];
+            }
+        }
+        return retval;
+    } optimised:^id{
+        return kqs::reject(dictionary, pairs);
+    }];
+    [self checkOperation:@"kqs::find(NSDictionary)" input:dictionary reference:^id{
+        NSMutableArray *retval = [[NSMutableArray alloc] init];
+
+        for (id key in dictionary) {
+            if (pairs(key,dictionary[key])) {
+                [retval addObject:dictionary[key]];
+            }
+        }
+        return retval;
+    } optimised:^id{
+        return kqs::find(dictionary, pairs);
+    } equal:anyMatch];
+    [self checkOperation:@"kqs::any(NSDictionary)" input:dictionary reference:^id{
+        for (id key in dictionary) {
+            if (pairs(key,dictionary[key])) {
+                return @YES;
+            }
+        }
+        return @NO;
+    } optimised:^id{
+        return @(kqs::any(dictionary, pairs));
+    }];
+    [self checkOperation:@"kqs::all(NSDictionary)" input:dictionary reference:^id{
+        for (id key in dictionary) {
+            if (pairs(key,dictionary[key])) {
+                return @NO;
+            }
+        }
+        return @YES;
+    } optimised:^id{
+        return @(kqs::all(dictionary, [&](id key, id value){ return !pairs(key, value); }));
+    }];
+    [self checkOperation:@"kqs::none(NSDictionary)" input:dictionary reference:^id{
+        for (id key in dictionary) {
+            if (pairs(key,dictionary[key])) {
+                return @NO;
+            }
+        }
+        return @YES;
+    } optimised:^id{
+        return @(kqs::none(dictionary, pairs));
+    }];
+    [self checkOperation:@"kqs::map(NSDictionary)" input:dictionary reference:^id{
+        NSMutableDictionary *retval = [[NSMutableDictionary alloc] init];
+
+        for (id key in dictionary) {
+            retval[key] = pairs(key,dictionary[key]) ? [NSNull null] : @[key,dictionary[key]];
+        }
+        return retval;
+    } optimised:^id{
+        return kqs::map(dictionary, [&](id key, id value) -> id { return pairs(key, value) ? nil : @[key,value]; });
+    }];
+    // wrapping addition is commutative, so the enumeration order does not matter
+    [self checkOperation:@"kqs::reduce(NSDictionary)" input:dictionary reference:^id{
+        NSUInteger retval = 0;
+
+        for (id key in dictionary) {
+            retval += [key hash] ^ [dictionary[key] hash] ^ salt;
+        }
+        return @(retval);
+    } optimised:^id{
+        return @(kqs::reduce(dictionary, (NSUInteger)0, [=](NSUInteger retval, id key, id value){ return retval + ([key hash] ^ [value hash] ^ salt); }));
+    }];
+    [self checkOperation:@"kqs::each(NSDictionary)" input:dictionary reference:^id{
+        return dictionary;
+    } optimised:^id{
+        NSMutableDictionary *retval = [[NSMutableDictionary alloc] init];
+
+        kqs::each(dictionary, [&](id key, id value){ retval[key] = value; });
+
+        return retval;
+    }];
+}
+
+@end
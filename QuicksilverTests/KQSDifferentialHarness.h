@@ -0,0 +1,120 @@
+//
+//  KQSDifferentialHarness.h
+//  QuicksilverTests-iOS
+//
+//  Created by William Towe on 10/19/26.
+//  Copyright © 2021 Kosoku Interactive, LLC. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ The name of the environment variable read by harnessWithProcessEnvironment for the seed, a decimal integer.
+ */
+FOUNDATION_EXTERN NSString *const KQSDifferentialHarnessSeedEnvironmentKey;
+/**
+ The name of the environment variable read by harnessWithProcessEnvironment for the number of iterations, a decimal integer.
+ */
+FOUNDATION_EXTERN NSString *const KQSDifferentialHarnessIterationsEnvironmentKey;
+
+/**
+ KQSDifferentialResult collects the outcome of every check of a single operation across a run of KQSDifferentialHarness.
+ */
+@interface KQSDifferentialResult : NSObject
+
+/**
+ The name of the operation, e.g. NSArray.KQS_map:.
+ */
+@property (readonly,copy,nonatomic) NSString *name;
+/**
+ The number of inputs the operation was checked against.
+ */
+@property (readonly,assign,nonatomic) NSUInteger checkCount;
+/**
+ A description of each input for which the reference and optimised results differed, including the seed and iteration needed to reproduce it.
+ */
+@property (readonly,copy,nonatomic) NSArray<NSString *> *failures;
+/**
+ The total time spent computing the reference results.
+ */
+@property (readonly,assign,nonatomic) NSTimeInterval referenceTime;
+/**
+ The total time spent computing the optimised results.
+ */
+@property (readonly,assign,nonatomic) NSTimeInterval optimisedTime;
+/**
+ The ratio of referenceTime to optimisedTime.
+ */
+@property (readonly,assign,nonatomic) double speedup;
+
+@end
+
+/**
+ KQSDifferentialHarness generates random collections of varied sizes, element types and nesting from a seed, runs each operator in a reference mode, a naive loop spelling out the documented semantics, and in its optimised mode, the library implementation, and records whether the results are equal and how long each mode took.
+
+ The harness only depends on Foundation, so it can run under XCTest (see KQSDifferentialTestCase) or headless on Linux against GNUstep (see scripts/differential-linux.sh).
+ */
+@interface KQSDifferentialHarness : NSObject
+
+/**
+ The seed the inputs are generated from. Running again with the same seed and iterations generates the same inputs.
+ */
+@property (readonly,assign,nonatomic) uint64_t seed;
+/**
+ The number of iterations, each of which generates fresh inputs for every operation.
+ */
+@property (readonly,assign,nonatomic) NSUInteger iterations;
+/**
+ A fingerprint of the contents of every input checked by the last call to run, or 0 before the first run. Runs with the same seed and iterations check the same inputs and so have the same fingerprint.
+ */
+@property (readonly,assign,nonatomic) uint64_t inputFingerprint;
+
+/**
+ Creates and returns a harness using the seed and iterations from the process environment, falling back to a fixed seed and 100 iterations.
+
+ @return The harness
+ */
++ (instancetype)harnessWithProcessEnvironment;
+
+/**
+ Creates and returns a harness with the provided *seed* and *iterations*.
+
+ @param seed The seed
+ @param iterations The number of iterations
+ @return The initialized harness
+ @exception NSException Thrown if iterations is 0
+ */
+- (instancetype)initWithSeed:(uint64_t)seed iterations:(NSUInteger)iterations NS_DESIGNATED_INITIALIZER;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/**
+ Runs every check and returns a result for each operation, sorted by name.
+
+ @return The results
+ */
+- (NSArray<KQSDifferentialResult *> *)run;
+/**
+ Returns a human readable table of *results*, one line per operation with its check count, failure count, the time spent in each mode and the speedup.
+
+ @param results The results returned by run
+ @return The report
+ */
+- (NSString *)reportForResults:(NSArray<KQSDifferentialResult *> *)results;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,2332 @@
+//
+//  KQSDifferentialHarness.m
+//  QuicksilverTests-iOS
+//
+//  Created by William Towe on 10/19/26.
+//  Copyright © 2021 Kosoku Interactive, LLC. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#import "KQSDifferentialHarnessPrivate.h"
+
+#import <Quicksilver/Quicksilver.h>
+
+#include <errno.h>
+#include <float.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+NSString *const KQSDifferentialHarnessSeedEnvironmentKey = @"KQS_DIFFERENTIAL_SEED";
+NSString *const KQSDifferentialHarnessIterationsEnvironmentKey = @"KQS_DIFFERENTIAL_ITERATIONS";
+
+static uint64_t const kKQSDifferentialHarnessDefaultSeed = 20261019;
+static NSUInteger const kKQSDifferentialHarnessDefaultIterations = 100;
+// failures past this many per operation are counted but not described
+static NSUInteger const kKQSDifferentialHarnessMaximumFailureDescriptions = 10;
+static NSUInteger const kKQSDifferentialHarnessMaximumDescriptionLength = 512;
+// the summation inputs are integers of at most 45 bits scaled by 2^-40, so any sum of them is exact in an __int128
+static int const kKQSDifferentialHarnessSummationScale = 40;
+// how long to wait for an asynchronous operator before recording it as hung
+static int64_t const kKQSDifferentialHarnessAsyncTimeout = 10;
+
+typedef NS_ENUM(NSInteger, KQSDifferentialHarnessNumberKind) {
+    KQSDifferentialHarnessNumberKindIntegral,
+    KQSDifferentialHarnessNumberKindFloatingPoint,
+    KQSDifferentialHarnessNumberKindDecimal
+};
+
+static NSTimeInterval KQSDifferentialHarnessNow(void) {
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (NSTimeInterval)now.tv_sec + (NSTimeInterval)now.tv_nsec / 1e9;
+}
+static id KQSDifferentialHarnessEvaluate(KQSDifferentialHarnessBlock block) {
+    @try {
+        return block();
+    }
+    @catch (NSException *exception) {
+        return exception;
+    }
+}
+static NSString *KQSDifferentialHarnessDescription(id object) {
+    NSString *retval = object == nil ? @"(nil)" : [object description];
+
+    if (retval.length > kKQSDifferentialHarnessMaximumDescriptionLength) {
+        retval = [[retval substringToIndex:kKQSDifferentialHarnessMaximumDescriptionLength] stringByAppendingString:@"..."];
+    }
+
+    return retval;
+}
+static KQSDifferentialHarnessNumberKind KQSDifferentialHarnessKindOfNumber(NSNumber *number) {
+    if ([number isKindOfClass:[NSDecimalNumber class]]) {
+        return KQSDifferentialHarnessNumberKindDecimal;
+    }
+    else if (strcmp(number.objCType, @encode(double)) == 0 ||
+             strcmp(number.objCType, @encode(float)) == 0) {
+
+        return KQSDifferentialHarnessNumberKindFloatingPoint;
+    }
+    return KQSDifferentialHarnessNumberKindIntegral;
+}
+// numbers are equal if they are of the same kind and, for floating point numbers, within tolerance of each other
+static KQSDifferentialHarnessEqualBlock KQSDifferentialHarnessNumbersEqual(double tolerance) {
+    return ^BOOL(NSNumber *expected, NSNumber *actual) {
+        if (![expected isKindOfClass:[NSNumber class]] ||
+            ![actual isKindOfClass:[NSNumber class]] ||
+            KQSDifferentialHarnessKindOfNumber(expected) != KQSDifferentialHarnessKindOfNumber(actual)) {
+
+            return NO;
+        }
+
+        switch (KQSDifferentialHarnessKindOfNumber(expected)) {
+            case KQSDifferentialHarnessNumberKindIntegral:
+                return expected.longLongValue == actual.longLongValue;
+            case KQSDifferentialHarnessNumberKindFloatingPoint:
+                return fabs(expected.doubleValue - actual.doubleValue) <= tolerance;
+            case KQSDifferentialHarnessNumberKindDecimal:
+                return [expected isEqualToNumber:actual];
+        }
+    };
+}
+
+// the reference for KQS_sum, where the type of first decides how every object is added
+static NSNumber *KQSDifferentialHarnessReferenceSum(NSArray<NSNumber *> *numbers, NSNumber *first) {
+    if (numbers.count == 0) {
+        return @0;
+    }
+
+    if ([first isKindOfClass:[NSDecimalNumber class]]) {
+        NSDecimalNumber *retval = [NSDecimalNumber zero];
+
+        for (NSNumber *number in numbers) {
+            retval = [retval decimalNumberByAdding:(NSDecimalNumber *)number];
+        }
+        return retval;
+    }
+    else if (KQSDifferentialHarnessKindOfNumber(first) == KQSDifferentialHarnessNumberKindFloatingPoint) {
+        double retval = 0.0;
+
+        for (NSNumber *number in numbers) {
+            retval += number.doubleValue;
+        }
+        return @(retval);
+    }
+    else {
+        NSInteger retval = 0;
+
+        for (NSNumber *number in numbers) {
+            retval += number.integerValue;
+        }
+        return @(retval);
+    }
+}
+// the correctly rounded sum of numbers generated by randomSummandsWithCount:
+static double KQSDifferentialHarnessExactSum(NSArray<NSNumber *> *numbers) {
+    __int128 retval = 0;
+
+    for (NSNumber *number in numbers) {
+        retval += (__int128)ldexp(number.doubleValue, kKQSDifferentialHarnessSummationScale);
+    }
+
+    // the conversion rounds to nearest and scaling by a power of two is exact
+    return ldexp((double)retval, -kKQSDifferentialHarnessSummationScale);
+}
+static double KQSDifferentialHarnessUlp(double value) {
+    value = fabs(value);
+
+    return nextafter(value, INFINITY) - value;
+}
+// the reference for KQS_product, where the type of first decides how every object is multiplied
+static NSNumber *KQSDifferentialHarnessReferenceProduct(NSArray<NSNumber *> *numbers, NSNumber *first) {
+    // the product of an empty collection is 0 rather than 1, the reference pins that behavior until it changes
+    if (numbers.count == 0) {
+        return @0;
+    }
+
+    if ([first isKindOfClass:[NSDecimalNumber class]]) {
+        NSDecimalNumber *retval = [NSDecimalNumber one];
+
+        for (NSNumber *number in numbers) {
+            retval = [retval decimalNumberByMultiplyingBy:(NSDecimalNumber *)number];
+        }
+        return retval;
+    }
+    else if (KQSDifferentialHarnessKindOfNumber(first) == KQSDifferentialHarnessNumberKindFloatingPoint) {
+        double retval = 1.0;
+
+        for (NSNumber *number in numbers) {
+            retval *= number.doubleValue;
+        }
+        return @(retval);
+    }
+    else {
+        NSInteger retval = 1;
+
+        for (NSNumber *number in numbers) {
+            retval *= number.integerValue;
+        }
+        return @(retval);
+    }
+}
+// the rounding error of a floating point product of numbers multiplied in any order, there is no cancellation so it is relative to the product itself
+static double KQSDifferentialHarnessProductTolerance(id<NSFastEnumeration> numbers) {
+    double magnitude = 1.0;
+    NSUInteger count = 0;
+
+    for (NSNumber *number in numbers) {
+        magnitude *= fabs(number.doubleValue);
+        count++;
+    }
+
+    return (double)(count + 2) * DBL_EPSILON * magnitude;
+}
+// the reference for KQS_maximum and KQS_minimum, the first object that no later object compares beyond in order
+static id KQSDifferentialHarnessReferenceExtreme(id<NSFastEnumeration> objects, NSComparisonResult order) {
+    id retval = nil;
+
+    for (id object in objects) {
+        if (retval == nil ||
+            [object compare:retval] == order) {
+
+            retval = object;
+        }
+    }
+    return retval;
+}
+// the reference for KQS_flatten, which flattens nested collections of the same class as the receiver and keeps every other object as is
+static void KQSDifferentialHarnessReferenceFlatten(id<NSFastEnumeration> collection, Class collectionClass, NSMutableArray *objects) {
+    for (id object in collection) {
+        if ([object isKindOfClass:collectionClass]) {
+            KQSDifferentialHarnessReferenceFlatten(object, collectionClass, objects);
+        }
+        else {
+            [objects addObject:object];
+        }
+    }
+}
+// the reference for KQS_eachLeaf:, appends @[keyPath, value] for every value that is not a non-empty dictionary, in enumeration order
+static void KQSDifferentialHarnessReferenceLeaves(NSDictionary *dictionary, NSArray *keyPath, NSMutableArray<NSArray *> *leaves) {
+    for (id key in dictionary) {
+        id value = dictionary[key];
+        NSArray *valueKeyPath = [keyPath arrayByAddingObject:key];
+
+        if ([value isKindOfClass:[NSDictionary class]] &&
+            [value count] > 0) {
+
+            KQSDifferentialHarnessReferenceLeaves(value, valueKeyPath, leaves);
+        }
+        else {
+            [leaves addObject:@[valueKeyPath,value]];
+        }
+    }
+}
+// replaces every dictionary in containers, starting at object, with an immutable copy
+static id KQSDifferentialHarnessReferenceFreeze(id object, NSHashTable *containers) {
+    if (![containers containsObject:object]) {
+        return object;
+    }
+
+    NSMutableDictionary *retval = [[NSMutableDictionary alloc] init];
+
+    for (id key in object) {
+        retval[key] = KQSDifferentialHarnessReferenceFreeze(object[key], containers);
+    }
+
+    return [retval copy];
+}
+// folds value into fingerprint using the splitmix64 finalizer
+static uint64_t KQSDifferentialHarnessMix(uint64_t fingerprint, uint64_t value) {
+    uint64_t retval = fingerprint ^ (value + 0x9E3779B97F4A7C15ULL + (fingerprint << 6) + (fingerprint >> 2));
+
+    retval = (retval ^ (retval >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    retval = (retval ^ (retval >> 27)) * 0x94D049BB133111EBULL;
+
+    return retval ^ (retval >> 31);
+}
+
+/**
+ A model object for the key path operators, which read its properties through their getters rather than KVC.
+ */
+@interface KQSDifferentialRecord : NSObject
+@property (copy,nonatomic) NSString *name;
+@property (assign,nonatomic) NSInteger age;
+@property (assign,nonatomic) double score;
+@property (assign,nonatomic,getter=isActive) BOOL active;
+@property (strong,nonatomic) KQSDifferentialRecord *child;
+@end
+
+@implementation KQSDifferentialRecord
+- (NSString *)description {
+    return [NSString stringWithFormat:@"<%@ name=%@ age=%ld score=%g active=%d child=%@>",NSStringFromClass(self.class),self.name,(long)self.age,self.score,(int)self.active,self.child];
+}
+@end
+
+// a fingerprint of the contents of object, unlike -hash it covers every element of a collection and never depends on addresses
+static uint64_t KQSDifferentialHarnessFingerprint(id object) {
+    if (object == nil ||
+        object == [NSNull null]) {
+
+        return 1;
+    }
+    else if ([object isKindOfClass:[NSString class]]) {
+        return [object hash];
+    }
+    else if ([object isKindOfClass:[NSDecimalNumber class]]) {
+        return [[object stringValue] hash];
+    }
+    else if ([object isKindOfClass:[NSNumber class]]) {
+        if (KQSDifferentialHarnessKindOfNumber(object) == KQSDifferentialHarnessNumberKindFloatingPoint) {
+            double value = [object doubleValue];
+            uint64_t bits;
+
+            memcpy(&bits, &value, sizeof(bits));
+
+            return bits;
+        }
+        return (uint64_t)[object longLongValue];
+    }
+    else if ([object isKindOfClass:[NSArray class]] ||
+             [object isKindOfClass:[NSOrderedSet class]]) {
+
+        uint64_t retval = [object count];
+
+        for (id element in object) {
+            retval = KQSDifferentialHarnessMix(retval, KQSDifferentialHarnessFingerprint(element));
+        }
+        return retval;
+    }
+    else if ([object isKindOfClass:[NSSet class]]) {
+        // summed, so the enumeration order does not matter
+        uint64_t retval = 0;
+
+        for (id element in object) {
+            retval += KQSDifferentialHarnessMix(0, KQSDifferentialHarnessFingerprint(element));
+        }
+        return KQSDifferentialHarnessMix(retval, [object count]);
+    }
+    else if ([object isKindOfClass:[NSDictionary class]]) {
+        uint64_t retval = 0;
+
+        for (id key in object) {
+            retval += KQSDifferentialHarnessMix(KQSDifferentialHarnessFingerprint(key), KQSDifferentialHarnessFingerprint(object[key]));
+        }
+        return KQSDifferentialHarnessMix(retval, [object count]);
+    }
+    else if ([object isKindOfClass:[KQSDifferentialRecord class]]) {
+        KQSDifferentialRecord *record = object;
+        uint64_t retval = KQSDifferentialHarnessFingerprint(record.name);
+
+        retval = KQSDifferentialHarnessMix(retval, (uint64_t)record.age);
+        retval = KQSDifferentialHarnessMix(retval, KQSDifferentialHarnessFingerprint(@(record.score)));
+        retval = KQSDifferentialHarnessMix(retval, record.active);
+
+        return KQSDifferentialHarnessMix(retval, KQSDifferentialHarnessFingerprint(record.child));
+    }
+    return NSStringFromClass([object class]).hash;
+}
+
+@interface KQSDifferentialResult ()
+@property (readwrite,copy,nonatomic) NSString *name;
+@property (readwrite,assign,nonatomic) NSUInteger checkCount;
+@property (readwrite,assign,nonatomic) NSTimeInterval referenceTime;
+@property (readwrite,assign,nonatomic) NSTimeInterval optimisedTime;
+@property (assign,nonatomic) NSUInteger failureCount;
+@property (strong,nonatomic) NSMutableArray<NSString *> *failureDescriptions;
+@end
+
+@implementation KQSDifferentialResult
+
+- (NSArray<NSString *> *)failures {
+    return [self.failureDescriptions copy];
+}
+- (double)speedup {
+    return self.optimisedTime > 0.0 ? self.referenceTime / self.optimisedTime : 0.0;
+}
+
+@end
+
+@interface KQSDifferentialHarness ()
+@property (readwrite,assign,nonatomic) uint64_t seed;
+@property (readwrite,assign,nonatomic) NSUInteger iterations;
+@property (readwrite,assign,nonatomic) uint64_t inputFingerprint;
+@property (assign,nonatomic) NSUInteger iteration;
+@property (strong,nonatomic) NSMutableDictionary<NSString *, KQSDifferentialResult *> *results;
+@property (copy,nonatomic) NSArray<NSString *> *keyPaths;
+@end
+
+@implementation KQSDifferentialHarness {
+    uint64_t _state;
+}
+
++ (instancetype)harnessWithProcessEnvironment {
+    NSDictionary<NSString *, NSString *> *environment = [NSProcessInfo processInfo].environment;
+    NSString *seed = environment[KQSDifferentialHarnessSeedEnvironmentKey];
+    NSInteger iterations = [environment[KQSDifferentialHarnessIterationsEnvironmentKey] integerValue];
+
+    return [[self alloc] initWithSeed:seed.length > 0 ? strtoull(seed.UTF8String, NULL, 10) : kKQSDifferentialHarnessDefaultSeed iterations:iterations > 0 ? (NSUInteger)iterations : kKQSDifferentialHarnessDefaultIterations];
+}
+
+- (instancetype)initWithSeed:(uint64_t)seed iterations:(NSUInteger)iterations {
+    NSParameterAssert(iterations > 0);
+
+    if (!(self = [super init]))
+        return nil;
+
+    _seed = seed;
+    _iterations = iterations;
+    _keyPaths = @[@"name",@"age",@"score",@"active",@"child.name",@"child.age",@"child.score"];
+
+    return self;
+}
+
+- (NSArray<KQSDifferentialResult *> *)run {
+    _state = self.seed;
+    self.inputFingerprint = 0;
+    self.results = [[NSMutableDictionary alloc] init];
+
+    // not checked here, because the result depends on timing or an unseeded generator rather than the input:
+    // the timeout and cancellation of the KQS_async... operators, see KQSAsyncTaskTestCase
+    // KQS_sample: and KQS_sampleWeighted: without a KQSRandom, whose seeded counterparts are checked by checkSample
+    for (NSUInteger iteration=0; iteration<self.iterations; iteration++) {
+        self.iteration = iteration;
+
+        @autoreleasepool {
+            [self checkMap];
+            [self checkFilterAndReject];
+            [self checkFindAndPredicates];
+            [self checkTakeAndDrop];
+            [self checkTakeWhileAndDropWhile];
+            [self checkZip];
+            [self checkSum];
+            [self checkProductAndExtremes];
+            [self checkReduceFloat];
+            [self checkSummation];
+            [self checkFlatten];
+            [self checkDeepFlatten];
+            [self checkKeyPaths];
+            [self checkAsync];
+            [self checkCpp];
+            [self checkPersistentVector];
+            [self checkSketches];
+            [self checkSample];
+        }
+    }
+
+    return [self.results.allValues sortedArrayUsingComparator:^NSComparisonResult(KQSDifferentialResult *first, KQSDifferentialResult *second) {
+        return [first.name compare:second.name];
+    }];
+}
+- (NSString *)reportForResults:(NSArray<KQSDifferentialResult *> *)results {
+    NSMutableString *retval = [[NSMutableString alloc] initWithFormat:@"seed %llu, %lu iterations\n",(unsigned long long)self.seed,(unsigned long)self.iterations];
+
+    for (KQSDifferentialResult *result in results) {
+        [retval appendFormat:@"%-64s %7lu checks %5lu failures %10.3fms reference %10.3fms optimised %7.2fx\n",result.name.UTF8String,(unsigned long)result.checkCount,(unsigned long)result.failureCount,result.referenceTime * 1000.0,result.optimisedTime * 1000.0,result.speedup];
+    }
+
+    return [retval copy];
+}
+
+#pragma mark *** Private Methods ***
+#pragma mark Checks
+- (void)checkOperation:(NSString *)name input:(id)input reference:(KQSDifferentialHarnessBlock)reference optimised:(KQSDifferentialHarnessBlock)optimised {
+    [self checkOperation:name input:input reference:reference optimised:optimised equal:^BOOL(id expected, id actual) {
+        return expected == actual || [expected isEqual:actual];
+    }];
+}
+- (void)checkOperation:(NSString *)name input:(id)input reference:(KQSDifferentialHarnessBlock)reference optimised:(KQSDifferentialHarnessBlock)optimised equal:(KQSDifferentialHarnessEqualBlock)equal {
+    KQSDifferentialResult *result = self.results[name];
+
+    if (result == nil) {
+        result = [[KQSDifferentialResult alloc] init];
+        result.name = name;
+        result.failureDescriptions = [[NSMutableArray alloc] init];
+
+        self.results[name] = result;
+    }
+
+    self.inputFingerprint = KQSDifferentialHarnessMix(KQSDifferentialHarnessMix(self.inputFingerprint, name.hash), KQSDifferentialHarnessFingerprint(input));
+
+    NSTimeInterval start = KQSDifferentialHarnessNow();
+    id expected = KQSDifferentialHarnessEvaluate(reference);
+    NSTimeInterval middle = KQSDifferentialHarnessNow();
+    id actual = KQSDifferentialHarnessEvaluate(optimised);
+    NSTimeInterval end = KQSDifferentialHarnessNow();
+
+    result.referenceTime += middle - start;
+    result.optimisedTime += end - middle;
+    result.checkCount += 1;
+
+    BOOL passed;
+
+    // an exception is only a pass if both modes throw the same one
+    if ([expected isKindOfClass:[NSException class]] ||
+        [actual isKindOfClass:[NSException class]]) {
+
+        passed = [expected isKindOfClass:[NSException class]] && [actual isKindOfClass:[NSException class]] && [((NSException *)expected).name isEqualToString:((NSException *)actual).name];
+    }
+    else {
+        passed = equal(expected, actual);
+    }
+
+    if (passed) {
+        return;
+    }
+
+    result.failureCount += 1;
+
+    if (result.failureDescriptions.count < kKQSDifferentialHarnessMaximumFailureDescriptions) {
+        [result.failureDescriptions addObject:[NSString stringWithFormat:@"%@ differs for seed %llu iteration %lu\ninput: %@\nexpected: %@\nactual: %@",name,(unsigned long long)self.seed,(unsigned long)self.iteration,KQSDifferentialHarnessDescription(input),KQSDifferentialHarnessDescription(expected),KQSDifferentialHarnessDescription(actual)]];
+    }
+}
+// invokes start, which passes the result of an asynchronous operation to finish on any thread, and blocks until it does, returning an NSError if it never does
+- (id)waitForAsyncOperation:(void(^)(void(^finish)(id result)))start {
+    dispatch_semaphore_t semaphore = dispatch_semaphore_create(0);
+    __block id retval = nil;
+
+    start(^(id result) {
+        retval = result;
+        dispatch_semaphore_signal(semaphore);
+    });
+
+    if (dispatch_semaphore_wait(semaphore, dispatch_time(DISPATCH_TIME_NOW, kKQSDifferentialHarnessAsyncTimeout * (int64_t)NSEC_PER_SEC)) != 0) {
+        return [NSError errorWithDomain:NSPOSIXErrorDomain code:ETIMEDOUT userInfo:nil];
+    }
+
+    return retval;
+}
+
+- (void)checkMap {
+    NSArray *array = [self randomArrayWithCount:[self randomCount] depth:2];
+    NSOrderedSet *orderedSet = [NSOrderedSet orderedSetWithArray:array];
+    NSSet *set = [NSSet setWithArray:array];
+    NSDictionary *dictionary = [self randomDictionaryWithCount:[self randomCount] depth:2];
+    // returns nil for roughly a third of the objects, which the operators replace with NSNull
+    id(^indexed)(id, NSInteger) = ^id(id object, NSInteger index) {
+        return ([object hash] + (NSUInteger)index) % 3 == 0 ? nil : @[object,@(index % 4)];
+    };
+    id(^unindexed)(id) = ^id(id object) {
+        return [object hash] % 3 == 0 ? nil : @[object];
+    };
+    id(^pairs)(id, id) = ^id(id key, id value) {
+        return [key hash] % 3 == 0 ? nil : @[key,value];
+    };
+
+    [self checkOperation:@"NSArray.KQS_map:" input:array reference:^id{
+        NSMutableArray *retval = [[NSMutableArray alloc] init];
+
+        for (NSUInteger i=0; i<array.count; i++) {
+            [retval addObject:indexed(array[i],i) ?: [NSNull null]];
+        }
+        return retval;
+    } optimised:^id{
+        return [array KQS_map:indexed];
+    }];
+    [self checkOperation:@"NSOrderedSet.KQS_map:" input:orderedSet reference:^id{
+        NSMutableOrderedSet *retval = [[NSMutableOrderedSet alloc] init];
+
+        for (NSUInteger i=0; i<orderedSet.count; i++) {
+            [retval addObject:indexed(orderedSet[i],i) ?: [NSNull null]];
+        }
+        return retval;
+    } optimised:^id{
+        return [orderedSet KQS_map:indexed];
+    }];
+    [self checkOperation:@"NSSet.KQS_map:" input:set reference:^id{
+        NSMutableSet *retval = [[NSMutableSet alloc] init];
+
+        for (id object in set) {
+            [retval addObject:unindexed(object) ?: [NSNull null]];
+        }
+        return retval;
+    } optimised:^id{
+        return [set KQS_map:unindexed];
+    }];
+    [self checkOperation:@"NSDictionary.KQS_map:" input:dictionary reference:^id{
+        NSMutableDictionary *retval = [[NSMutableDictionary alloc] init];
+
+        for (id key in dictionary) {
+            retval[key] = pairs(key,dictionary[key]) ?: [NSNull null];
+        }
+        return retval;
+    } optimised:^id{
+        return [dictionary KQS_map:pairs];
+    }];
+}
+- (void)checkFilterAndReject {
+    NSArray *array = [self randomArrayWithCount:[self randomCount] depth:2];
+    NSOrderedSet *orderedSet = [NSOrderedSet orderedSetWithArray:array];
+    NSSet *set = [NSSet setWithArray:array];
+    NSDictionary *dictionary = [self randomDictionaryWithCount:[self randomCount] depth:2];
+    BOOL(^indexed)(id, NSInteger) = ^BOOL(id object, NSInteger index) {
+        return (([object hash] ^ (NSUInteger)index) & 1) == 0;
+    };
+    BOOL(^unindexed)(id) = ^BOOL(id object) {
+        return ([object hash] & 1) == 0;
+    };
+    BOOL(^pairs)(id, id) = ^BOOL(id key, id value) {
+        return (([key hash] ^ [value hash]) & 1) == 0;
+    };
+
+    for (NSNumber *passes in @[@YES,@NO]) {
+        NSString *suffix = passes.boolValue ? @"KQS_filter:" : @"KQS_reject:";
+
+        [self checkOperation:[@"NSArray." stringByAppendingString:suffix] input:array reference:^id{
+            NSMutableArray *retval = [[NSMutableArray alloc] init];
+
+            for (NSUInteger i=0; i<array.count; i++) {
+                if (indexed(array[i],i) == passes.boolValue) {
+                    [retval addObject:array[i]];
+                }
+            }
+            return retval;
+        } optimised:^id{
+            return passes.boolValue ? [array KQS_filter:indexed] : [array KQS_reject:indexed];
+        }];
+        [self checkOperation:[@"NSOrderedSet." stringByAppendingString:suffix] input:orderedSet reference:^id{
+            NSMutableOrderedSet *retval = [[NSMutableOrderedSet alloc] init];
+
+            for (NSUInteger i=0; i<orderedSet.count; i++) {
+                if (indexed(orderedSet[i],i) == passes.boolValue) {
+                    [retval addObject:orderedSet[i]];
+                }
+            }
+            return retval;
+        } optimised:^id{
+            return passes.boolValue ? [orderedSet KQS_filter:indexed] : [orderedSet KQS_reject:indexed];
+        }];
+        [self checkOperation:[@"NSSet." stringByAppendingString:suffix] input:set reference:^id{
+            NSMutableSet *retval = [[NSMutableSet alloc] init];
+
+            for (id object in set) {
+                if (unindexed(object) == passes.boolValue) {
+                    [retval addObject:object];
+                }
+            }
+            return retval;
+        } optimised:^id{
+            return passes.boolValue ? [set KQS_filter:unindexed] : [set KQS_reject:unindexed];
+        }];
+        [self checkOperation:[@"NSDictionary." stringByAppendingString:suffix] input:dictionary reference:^id{
+            NSMutableDictionary *retval = [[NSMutableDictionary alloc] init];
+
+            for (id key in dictionary) {
+                if (pairs(key,dictionary[key]) == passes.boolValue) {
+                    retval[key] = dictionary[key];
+                }
+            }
+            return retval;
+        } optimised:^id{
+            return passes.boolValue ? [dictionary KQS_filter:pairs] : [dictionary KQS_reject:pairs];
+        }];
+    }
+}
+- (void)checkFindAndPredicates {
+    NSArray *array = [self randomArrayWithCount:[self randomCount] depth:1];
+    NSOrderedSet *orderedSet = [NSOrderedSet orderedSetWithArray:array];
+    NSSet *set = [NSSet setWithArray:array];
+    NSDictionary *dictionary = [self randomDictionaryWithCount:[self randomCount] depth:1];
+    // passes for roughly one object in divisor, so small collections often have no match and large ones match early
+    NSUInteger salt = (NSUInteger)[self nextRandom];
+    NSUInteger divisor = 1 + [self randomBelow:32];
+    BOOL(^indexed)(id, NSInteger) = ^BOOL(id object, NSInteger index) {
+        return (([object hash] ^ salt) + (NSUInteger)index) % divisor == 0;
+    };
+    BOOL(^unindexed)(id) = ^BOOL(id object) {
+        return ([object hash] ^ salt) % divisor == 0;
+    };
+    BOOL(^pairs)(id, id) = ^BOOL(id key, id value) {
+        return ([key hash] ^ [value hash] ^ salt) % divisor == 0;
+    };
+    // KQS_all: is checked with the negated predicates, which hold for every object exactly when nothing matches
+    BOOL(^indexedMisses)(id, NSInteger) = ^BOOL(id object, NSInteger index) {
+        return !indexed(object,index);
+    };
+    BOOL(^unindexedMisses)(id) = ^BOOL(id object) {
+        return !unindexed(object);
+    };
+    BOOL(^pairsMiss)(id, id) = ^BOOL(id key, id value) {
+        return !pairs(key,value);
+    };
+    // the enumeration order of sets and dictionaries is unspecified, so any match is accepted
+    KQSDifferentialHarnessEqualBlock anyMatch = ^BOOL(NSArray *expected, id actual) {
+        return expected.count == 0 ? actual == nil : [expected containsObject:actual];
+    };
+
+    [self checkOperation:@"NSArray.KQS_find:" input:array reference:^id{
+        for (NSUInteger i=0; i<array.count; i++) {
+            if (indexed(array[i],i)) {
+                return array[i];
+            }
+        }
+        return nil;
+    } optimised:^id{
+        return [array KQS_find:indexed];
+    }];
+    [self checkOperation:@"NSArray.KQS_findWithIndex:" input:array reference:^id{
+        for (NSUInteger i=0; i<array.count; i++) {
+            if (indexed(array[i],i)) {
+                return @[array[i],@(i)];
+            }
+        }
+        return nil;
+    } optimised:^id{
+        return [array KQS_findWithIndex:indexed];
+    }];
+    [self checkOperation:@"NSArray.KQS_any:" input:array reference:^id{
+        for (NSUInteger i=0; i<array.count; i++) {
+            if (indexed(array[i],i)) {
+                return @YES;
+            }
+        }
+        return @NO;
+    } optimised:^id{
+        return @([array KQS_any:indexed]);
+    }];
+    [self checkOperation:@"NSArray.KQS_all:" input:array reference:^id{
+        for (NSUInteger i=0; i<array.count; i++) {
+            if (!indexedMisses(array[i],i)) {
+                return @NO;
+            }
+        }
+        return @YES;
+    } optimised:^id{
+        return @([array KQS_all:indexedMisses]);
+    }];
+    [self checkOperation:@"NSArray.KQS_none:" input:array reference:^id{
+        for (NSUInteger i=0; i<array.count; i++) {
+            if (indexed(array[i],i)) {
+                return @NO;
+            }
+        }
+        return @YES;
+    } optimised:^id{
+        return @([array KQS_none:indexed]);
+    }];
+    [self checkOperation:@"NSOrderedSet.KQS_find:" input:orderedSet reference:^id{
+        for (NSUInteger i=0; i<orderedSet.count; i++) {
+            if (indexed(orderedSet[i],i)) {
+                return orderedSet[i];
+            }
+        }
+        return nil;
+    } optimised:^id{
+        return [orderedSet KQS_find:indexed];
+    }];
+    [self checkOperation:@"NSOrderedSet.KQS_findWithIndex:" input:orderedSet reference:^id{
+        for (NSUInteger i=0; i<orderedSet.count; i++) {
+            if (indexed(orderedSet[i],i)) {
+                return @[orderedSet[i],@(i)];
+            }
+        }
+        return nil;
+    } optimised:^id{
+        return [orderedSet KQS_findWithIndex:indexed];
+    }];
+    [self checkOperation:@"NSOrderedSet.KQS_any:" input:orderedSet reference:^id{
+        for (NSUInteger i=0; i<orderedSet.count; i++) {
+            if (indexed(orderedSet[i],i)) {
+                return @YES;
+            }
+        }
+        return @NO;
+    } optimised:^id{
+        return @([orderedSet KQS_any:indexed]);
+    }];
+    [self checkOperation:@"NSOrderedSet.KQS_all:" input:orderedSet reference:^id{
+        for (NSUInteger i=0; i<orderedSet.count; i++) {
+            if (!indexedMisses(orderedSet[i],i)) {
+                return @NO;
+            }
+        }
+        return @YES;
+    } optimised:^id{
+        return @([orderedSet KQS_all:indexedMisses]);
+    }];
+    [self checkOperation:@"NSOrderedSet.KQS_none:" input:orderedSet reference:^id{
+        for (NSUInteger i=0; i<orderedSet.count; i++) {
+            if (indexed(orderedSet[i],i)) {
+                return @NO;
+            }
+        }
+        return @YES;
+    } optimised:^id{
+        return @([orderedSet KQS_none:indexed]);
+    }];
+    [self checkOperation:@"NSSet.KQS_find:" input:set reference:^id{
+        NSMutableArray *retval = [[NSMutableArray alloc] init];
+
+        for (id object in set) {
+            if (unindexed(object)) {
+                [retval addObject:object];
+            }
+        }
+        return retval;
+    } optimised:^id{
+        return [set KQS_find:unindexed];
+    } equal:anyMatch];
+    [self checkOperation:@"NSSet.KQS_any:" input:set reference:^id{
+        for (id object in set) {
+            if (unindexed(object)) {
+                return @YES;
+            }
+        }
+        return @NO;
+    } optimised:^id{
+        return @([set KQS_any:unindexed]);
+    }];
+    [self checkOperation:@"NSSet.KQS_all:" input:set reference:^id{
+        for (id object in set) {
+            if (!unindexedMisses(object)) {
+                return @NO;
+            }
+        }
+        return @YES;
+    } optimised:^id{
+        return @([set KQS_all:unindexedMisses]);
+    }];
+    [self checkOperation:@"NSSet.KQS_none:" input:set reference:^id{
+        for (id object in set) {
+            if (unindexed(object)) {
+                return @NO;
+            }
+        }
+        return @YES;
+    } optimised:^id{
+        return @([set KQS_none:unindexed]);
+    }];
+    [self checkOperation:@"NSDictionary.KQS_find:" input:dictionary reference:^id{
+        NSMutableArray *retval = [[NSMutableArray alloc] init];
+
+        for (id key in dictionary) {
+            if (pairs(key,dictionary[key])) {
+                [retval addObject:dictionary[key]];
+            }
+        }
+        return retval;
+    } optimised:^id{
+        return [dictionary KQS_find:pairs];
+    } equal:anyMatch];
+    [self checkOperation:@"NSDictionary.KQS_findWithKey:" input:dictionary reference:^id{
+        NSMutableDictionary *retval = [[NSMutableDictionary alloc] init];
+
+        for (id key in dictionary) {
+            if (pairs(key,dictionary[key])) {
+                retval[key] = dictionary[key];
+            }
+        }
+        return retval;
+    } optimised:^id{
+        return [dictionary KQS_findWithKey:pairs];
+    } equal:^BOOL(NSDictionary *expected, NSDictionary *actual) {
+        if (expected.count == 0) {
+            return actual == nil;
+        }
+
+        id key = actual.allKeys.firstObject;
+
+        return actual.count == 1 && [expected[key] isEqual:actual[key]];
+    }];
+    [self checkOperation:@"NSDictionary.KQS_any:" input:dictionary reference:^id{
+        for (id key in dictionary) {
+            if (pairs(key,dictionary[key])) {
+                return @YES;
+            }
+        }
+        return @NO;
+    } optimised:^id{
+        return @([dictionary KQS_any:pairs]);
+    }];
+    [self checkOperation:@"NSDictionary.KQS_all:" input:dictionary reference:^id{
+        for (id key in dictionary) {
+            if (!pairsMiss(key,dictionary[key])) {
+                return @NO;
+            }
+        }
+        return @YES;
+    } optimised:^id{
+        return @([dictionary KQS_all:pairsMiss]);
+    }];
+    [self checkOperation:@"NSDictionary.KQS_none:" input:dictionary reference:^id{
+        for (id key in dictionary) {
+            if (pairs(key,dictionary[key])) {
+                return @NO;
+            }
+        }
+        return @YES;
+    } optimised:^id{
+        return @([dictionary KQS_none:pairs]);
+    }];
+}
+- (void)checkTakeAndDrop {
+    NSArray *array = [self randomArrayWithCount:[self randomCount] depth:1];
+    NSOrderedSet *orderedSet = [NSOrderedSet orderedSetWithArray:array];
+    // includes counts past the end and, occasionally, a negative count
+    NSInteger count = [self randomChance:0.1] ? -1 : (NSInteger)[self randomBelow:array.count + 6];
+    // the counts are compared unsigned, so a negative count takes every object and drops every object
+    NSUInteger limit = (NSUInteger)count;
+    NSDictionary *input = @{@"collection": array, @"count": @(count)};
+
+    [self checkOperation:@"NSArray.KQS_take:" input:input reference:^id{
+        NSMutableArray *retval = [[NSMutableArray alloc] init];
+
+        for (NSUInteger i=0; i<array.count && i<limit; i++) {
+            [retval addObject:array[i]];
+        }
+        return retval;
+    } optimised:^id{
+        return [array KQS_take:count];
+    }];
+    [self checkOperation:@"NSArray.KQS_drop:" input:input reference:^id{
+        NSMutableArray *retval = [[NSMutableArray alloc] init];
+
+        for (NSUInteger i=limit; i<array.count; i++) {
+            [retval addObject:array[i]];
+        }
+        return retval;
+    } optimised:^id{
+        return [array KQS_drop:count];
+    }];
+
+    input = @{@"collection": orderedSet, @"count": @(count)};
+
+    [self checkOperation:@"NSOrderedSet.KQS_take:" input:input reference:^id{
+        NSMutableOrderedSet *retval = [[NSMutableOrderedSet alloc] init];
+
+        for (NSUInteger i=0; i<orderedSet.count && i<limit; i++) {
+            [retval addObject:orderedSet[i]];
+        }
+        return retval;
+    } optimised:^id{
+        return [orderedSet KQS_take:count];
+    }];
+    [self checkOperation:@"NSOrderedSet.KQS_drop:" input:input reference:^id{
+        // KQS_drop: on NSOrderedSet keeps the first count - n objects rather than the last, the reference pins that behavior until it changes
+        NSUInteger keep = limit > orderedSet.count ? 0 : orderedSet.count - limit;
+        NSMutableOrderedSet *retval = [[NSMutableOrderedSet alloc] init];
+
+        for (NSUInteger i=0; i<keep; i++) {
+            [retval addObject:orderedSet[i]];
+        }
+        return retval;
+    } optimised:^id{
+        return [orderedSet KQS_drop:count];
+    }];
+}
+- (void)checkTakeWhileAndDropWhile {
+    NSArray *array = [self randomArrayWithCount:[self randomCount] depth:1];
+    // holds for a random prefix and then for most objects, so the run ends anywhere from the first object to past the last
+    NSUInteger prefix = [self randomBelow:array.count + 2];
+    NSUInteger salt = (NSUInteger)[self nextRandom];
+    BOOL(^block)(id, NSInteger) = ^BOOL(id object, NSInteger index) {
+        return (NSUInteger)index < prefix || (([object hash] ^ salt) & 7) != 0;
+    };
+    NSDictionary *input = @{@"collection": array, @"prefix": @(prefix), @"salt": @(salt)};
+
+    [self checkOperation:@"NSArray.KQS_takeWhile:" input:input reference:^id{
+        NSMutableArray *retval = [[NSMutableArray alloc] init];
+
+        for (NSUInteger i=0; i<array.count && block(array[i],i); i++) {
+            [retval addObject:array[i]];
+        }
+        return retval;
+    } optimised:^id{
+        return [array KQS_takeWhile:block];
+    }];
+    [self checkOperation:@"NSArray.KQS_dropWhile:" input:input reference:^id{
+        NSMutableArray *retval = [[NSMutableArray alloc] init];
+        NSUInteger i = 0;
+
+        while (i < array.count && block(array[i],i)) {
+            i++;
+        }
+        for (; i<array.count; i++) {
+            [retval addObject:array[i]];
+        }
+        return retval;
+    } optimised:^id{
+        return [array KQS_dropWhile:block];
+    }];
+}
+- (void)checkZip {
+    NSArray *array = [self randomArrayWithCount:[self randomCount] depth:1];
+    NSArray *other = [self randomArrayWithCount:[self randomCount] depth:1];
+    NSOrderedSet *orderedSet = [NSOrderedSet orderedSetWithArray:array];
+    NSOrderedSet *otherOrderedSet = [NSOrderedSet orderedSetWithArray:other];
+
+    [self checkOperation:@"NSArray.KQS_zip:" input:@[array,other] reference:^id{
+        NSMutableArray *retval = [[NSMutableArray alloc] init];
+
+        for (NSUInteger i=0; i<array.count && i<other.count; i++) {
+            [retval addObject:@[array[i],other[i]]];
+        }
+        return retval;
+    } optimised:^id{
+        return [array KQS_zip:other];
+    }];
+    [self checkOperation:@"NSOrderedSet.KQS_zip:" input:@[orderedSet,otherOrderedSet] reference:^id{
+        // each pair is itself an ordered set, so equal objects collapse into a single object pair, and equal pairs collapse as well
+        NSMutableOrderedSet *retval = [[NSMutableOrderedSet alloc] init];
+
+        for (NSUInteger i=0; i<orderedSet.count && i<otherOrderedSet.count; i++) {
+            [retval addObject:[NSOrderedSet orderedSetWithObjects:orderedSet[i],otherOrderedSet[i], nil]];
+        }
+        return retval;
+    } optimised:^id{
+        return [orderedSet KQS_zip:otherOrderedSet];
+    }];
+}
+- (void)checkSum {
+    NSArray<NSNumber *> *array = [self randomNumbersWithCount:[self randomCount]];
+    NSOrderedSet<NSNumber *> *orderedSet = [NSOrderedSet orderedSetWithArray:array];
+    NSSet<NSNumber *> *set = [NSSet setWithArray:array];
+    NSMutableDictionary<NSNumber *, NSNumber *> *dictionary = [[NSMutableDictionary alloc] init];
+    double magnitude = 0.0;
+
+    for (NSUInteger i=0; i<array.count; i++) {
+        dictionary[@(i)] = array[i];
+        magnitude += fabs(array[i].doubleValue);
+    }
+
+    // sets and dictionaries may enumerate in a different order than their allObjects and allValues, which changes the rounding of floating point sums
+    KQSDifferentialHarnessEqualBlock unordered = KQSDifferentialHarnessNumbersEqual((double)(array.count + 2) * DBL_EPSILON * magnitude);
+
+    [self checkOperation:@"NSArray.KQS_sum" input:array reference:^id{
+        return KQSDifferentialHarnessReferenceSum(array, array.firstObject);
+    } optimised:^id{
+        return [array KQS_sum];
+    } equal:KQSDifferentialHarnessNumbersEqual(0.0)];
+    [self checkOperation:@"NSOrderedSet.KQS_sum" input:orderedSet reference:^id{
+        return KQSDifferentialHarnessReferenceSum(orderedSet.array, orderedSet.firstObject);
+    } optimised:^id{
+        return [orderedSet KQS_sum];
+    } equal:KQSDifferentialHarnessNumbersEqual(0.0)];
+    [self checkOperation:@"NSSet.KQS_sum" input:set reference:^id{
+        return KQSDifferentialHarnessReferenceSum(set.allObjects, set.anyObject);
+    } optimised:^id{
+        return [set KQS_sum];
+    } equal:unordered];
+    [self checkOperation:@"NSDictionary.KQS_sumOfValues" input:dictionary reference:^id{
+        NSArray *values = dictionary.allValues;
+
+        return KQSDifferentialHarnessReferenceSum(values, values.firstObject);
+    } optimised:^id{
+        return [dictionary KQS_sumOfValues];
+    } equal:unordered];
+}
+- (void)checkProductAndExtremes {
+    NSArray<NSNumber *> *factors = [self randomFactorsWithCount:[self randomBelow:7]];
+    NSOrderedSet<NSNumber *> *orderedFactors = [NSOrderedSet orderedSetWithArray:factors];
+    NSSet<NSNumber *> *setOfFactors = [NSSet setWithArray:factors];
+    NSArray<NSNumber *> *valueFactors = [self randomFactorsWithCount:factors.count];
+    NSMutableDictionary<NSNumber *, NSNumber *> *dictionaryOfFactors = [[NSMutableDictionary alloc] init];
+    NSArray<NSNumber *> *array = [self randomNumbersWithCount:[self randomCount]];
+    NSOrderedSet<NSNumber *> *orderedSet = [NSOrderedSet orderedSetWithArray:array];
+    NSSet<NSNumber *> *set = [NSSet setWithArray:array];
+    NSArray<NSNumber *> *values = [self randomNumbersWithCount:array.count];
+    NSMutableDictionary<NSNumber *, NSNumber *> *dictionary = [[NSMutableDictionary alloc] init];
+    KQSDifferentialHarnessEqualBlock identical = ^BOOL(id expected, id actual) {
+        return expected == actual;
+    };
+
+    for (NSUInteger i=0; i<factors.count; i++) {
+        dictionaryOfFactors[factors[i]] = valueFactors[i];
+    }
+    for (NSUInteger i=0; i<array.count; i++) {
+        dictionary[array[i]] = values[i];
+    }
+
+    [self checkOperation:@"NSArray.KQS_product" input:factors reference:^id{
+        return KQSDifferentialHarnessReferenceProduct(factors, factors.firstObject);
+    } optimised:^id{
+        return [factors KQS_product];
+    } equal:KQSDifferentialHarnessNumbersEqual(0.0)];
+    [self checkOperation:@"NSOrderedSet.KQS_product" input:orderedFactors reference:^id{
+        return KQSDifferentialHarnessReferenceProduct(orderedFactors.array, orderedFactors.firstObject);
+    } optimised:^id{
+        return [orderedFactors KQS_product];
+    } equal:KQSDifferentialHarnessNumbersEqual(0.0)];
+    // sets and dictionaries may enumerate in a different order than their allObjects, allKeys and allValues, which changes the rounding of floating point products
+    [self checkOperation:@"NSSet.KQS_product" input:setOfFactors reference:^id{
+        return KQSDifferentialHarnessReferenceProduct(setOfFactors.allObjects, setOfFactors.anyObject);
+    } optimised:^id{
+        return [setOfFactors KQS_product];
+    } equal:KQSDifferentialHarnessNumbersEqual(KQSDifferentialHarnessProductTolerance(setOfFactors))];
+    [self checkOperation:@"NSDictionary.KQS_productOfKeys" input:dictionaryOfFactors reference:^id{
+        NSArray *keys = dictionaryOfFactors.allKeys;
+
+        return KQSDifferentialHarnessReferenceProduct(keys, keys.firstObject);
+    } optimised:^id{
+        return [dictionaryOfFactors KQS_productOfKeys];
+    } equal:KQSDifferentialHarnessNumbersEqual(KQSDifferentialHarnessProductTolerance(dictionaryOfFactors.allKeys))];
+    [self checkOperation:@"NSDictionary.KQS_productOfValues" input:dictionaryOfFactors reference:^id{
+        NSArray *factorValues = dictionaryOfFactors.allValues;
+
+        return KQSDifferentialHarnessReferenceProduct(factorValues, factorValues.firstObject);
+    } optimised:^id{
+        return [dictionaryOfFactors KQS_productOfValues];
+    } equal:KQSDifferentialHarnessNumbersEqual(KQSDifferentialHarnessProductTolerance(dictionaryOfFactors.allValues))];
+
+    for (NSNumber *order in @[@(NSOrderedDescending),@(NSOrderedAscending)]) {
+        NSComparisonResult comparison = (NSComparisonResult)order.integerValue;
+        NSString *suffix = comparison == NSOrderedDescending ? @"maximum" : @"minimum";
+
+        // equal numbers compare the same, so the first of them must be chosen
+        [self checkOperation:[@"NSArray.KQS_" stringByAppendingString:suffix] input:array reference:^id{
+            return KQSDifferentialHarnessReferenceExtreme(array, comparison);
+        } optimised:^id{
+            return comparison == NSOrderedDescending ? [array KQS_maximum] : [array KQS_minimum];
+        } equal:identical];
+        [self checkOperation:[@"NSOrderedSet.KQS_" stringByAppendingString:suffix] input:orderedSet reference:^id{
+            return KQSDifferentialHarnessReferenceExtreme(orderedSet, comparison);
+        } optimised:^id{
+            return comparison == NSOrderedDescending ? [orderedSet KQS_maximum] : [orderedSet KQS_minimum];
+        } equal:identical];
+        // numbers that compare the same are equal, so the choice between them is not checked for sets and dictionaries
+        [self checkOperation:[@"NSSet.KQS_" stringByAppendingString:suffix] input:set reference:^id{
+            return KQSDifferentialHarnessReferenceExtreme(set, comparison);
+        } optimised:^id{
+            return comparison == NSOrderedDescending ? [set KQS_maximum] : [set KQS_minimum];
+        }];
+        [self checkOperation:[NSString stringWithFormat:@"NSDictionary.KQS_%@Key",suffix] input:dictionary reference:^id{
+            return KQSDifferentialHarnessReferenceExtreme(dictionary.allKeys, comparison);
+        } optimised:^id{
+            return comparison == NSOrderedDescending ? [dictionary KQS_maximumKey] : [dictionary KQS_minimumKey];
+        }];
+        [self checkOperation:[NSString stringWithFormat:@"NSDictionary.KQS_%@Value",suffix] input:dictionary reference:^id{
+            return KQSDifferentialHarnessReferenceExtreme(dictionary.allValues, comparison);
+        } optimised:^id{
+            return comparison == NSOrderedDescending ? [dictionary KQS_maximumValue] : [dictionary KQS_minimumValue];
+        }];
+    }
+}
+- (void)checkReduceFloat {
+    NSArray<NSNumber *> *array = [self randomDoublesWithCount:[self randomCount]];
+    NSOrderedSet<NSNumber *> *orderedSet = [NSOrderedSet orderedSetWithArray:array];
+    CGFloat start = (CGFloat)[self randomFloatingPoint].doubleValue;
+    CGFloat(^block)(CGFloat, NSNumber *, NSInteger) = ^CGFloat(CGFloat sum, NSNumber *object, NSInteger index) {
+        return index % 2 == 0 ? sum + (CGFloat)object.doubleValue : sum - (CGFloat)object.doubleValue;
+    };
+
+    [self checkOperation:@"NSArray.KQS_reduceFloatWithStart:block:" input:array reference:^id{
+        CGFloat retval = start;
+
+        for (NSUInteger i=0; i<array.count; i++) {
+            retval = block(retval,array[i],i);
+        }
+        return @(retval);
+    } optimised:^id{
+        return @([array KQS_reduceFloatWithStart:start block:block]);
+    }];
+    [self checkOperation:@"NSOrderedSet.KQS_reduceFloatWithStart:block:" input:orderedSet reference:^id{
+        CGFloat retval = start;
+
+        for (NSUInteger i=0; i<orderedSet.count; i++) {
+            retval = block(retval,orderedSet[i],i);
+        }
+        return @(retval);
+    } optimised:^id{
+        return @([orderedSet KQS_reduceFloatWithStart:start block:block]);
+    }];
+}
+- (void)checkSummation {
+    NSArray<NSNumber *> *array = [self randomSummandsWithCount:[self randomLargeCount]];
+    double exact = KQSDifferentialHarnessExactSum(array);
+    double magnitude = 0.0;
+
+    for (NSNumber *number in array) {
+        magnitude += fabs(number.doubleValue);
+    }
+
+    // compensated summation is within a few ulps of the exact sum, plus a term quadratic in DBL_EPSILON that only matters under heavy cancellation
+    double preciseTolerance = 4.0 * KQSDifferentialHarnessUlp(exact) + 4.0 * (double)array.count * DBL_EPSILON * DBL_EPSILON * magnitude;
+    // pairwise summation grows with the depth of the tree, 128 value blocks over 8 accumulators plus one level per halving, where a plain loop grows with the count
+    double pairwiseTolerance = (20.0 + ceil(log2((double)MAX(array.count, 1)))) * DBL_EPSILON * magnitude;
+
+    [self checkOperation:@"NSArray.KQS_sumPrecise" input:array reference:^id{
+        return @(exact);
+    } optimised:^id{
+        return [array KQS_sumPrecise];
+    } equal:KQSDifferentialHarnessNumbersEqual(preciseTolerance)];
+    [self checkOperation:@"NSArray.KQS_sumPairwise" input:array reference:^id{
+        return @(exact);
+    } optimised:^id{
+        return [array KQS_sumPairwise];
+    } equal:KQSDifferentialHarnessNumbersEqual(pairwiseTolerance)];
+    // the concurrent sum must be bitwise identical to the serial one
+    [self checkOperation:@"NSArray.KQS_sumPairwiseConcurrently" input:array reference:^id{
+        return [array KQS_sumPairwise];
+    } optimised:^id{
+        return [array KQS_sumPairwiseConcurrently];
+    } equal:KQSDifferentialHarnessNumbersEqual(0.0)];
+
+    // a plain loop loses the 1 entirely, compensated summation must recover it exactly
+    NSArray<NSNumber *> *illConditioned = @[@1e16,@1.0,@-1e16];
+
+    [self checkOperation:@"NSArray.KQS_sumPrecise (ill conditioned)" input:illConditioned reference:^id{
+        return @1.0;
+    } optimised:^id{
+        return [illConditioned KQS_sumPrecise];
+    } equal:KQSDifferentialHarnessNumbersEqual(0.0)];
+}
+- (void)checkFlatten {
+    NSArray *array = [self randomArrayWithCount:[self randomCount] depth:3];
+    NSMutableArray *orderedSetObjects = [[NSMutableArray alloc] init];
+    NSMutableArray *setObjects = [[NSMutableArray alloc] init];
+    NSMutableDictionary<id, NSDictionary *> *dictionary = [[NSMutableDictionary alloc] init];
+
+    // nest ordered sets and sets in place of the nested arrays, which is what their KQS_flatten looks for
+    for (id object in array) {
+        BOOL nested = [object isKindOfClass:[NSArray class]];
+
+        [orderedSetObjects addObject:nested ? [NSOrderedSet orderedSetWithArray:object] : object];
+        [setObjects addObject:nested ? [NSSet setWithArray:object] : object];
+    }
+    // the nested dictionaries share keys, so later ones replace the values of earlier ones
+    for (NSUInteger i=0, count=[self randomBelow:9]; i<count; i++) {
+        dictionary[[self randomString]] = [self randomDictionaryWithCount:[self randomBelow:9] depth:0];
+    }
+
+    NSOrderedSet *orderedSet = [NSOrderedSet orderedSetWithArray:orderedSetObjects];
+    NSSet *set = [NSSet setWithArray:setObjects];
+
+    [self checkOperation:@"NSArray.KQS_flatten" input:array reference:^id{
+        NSMutableArray *retval = [[NSMutableArray alloc] init];
+
+        KQSDifferentialHarnessReferenceFlatten(array, [NSArray class], retval);
+
+        return retval;
+    } optimised:^id{
+        return [array KQS_flatten];
+    }];
+    [self checkOperation:@"NSOrderedSet.KQS_flatten" input:orderedSet reference:^id{
+        NSMutableArray *retval = [[NSMutableArray alloc] init];
+
+        KQSDifferentialHarnessReferenceFlatten(orderedSet, [NSOrderedSet class], retval);
+
+        return [NSOrderedSet orderedSetWithArray:retval];
+    } optimised:^id{
+        return [orderedSet KQS_flatten];
+    }];
+    [self checkOperation:@"NSSet.KQS_flatten" input:set reference:^id{
+        NSMutableArray *retval = [[NSMutableArray alloc] init];
+
+        KQSDifferentialHarnessReferenceFlatten(set, [NSSet class], retval);
+
+        return [NSSet setWithArray:retval];
+    } optimised:^id{
+        return [set KQS_flatten];
+    }];
+    [self checkOperation:@"NSDictionary.KQS_flatten" input:dictionary reference:^id{
+        NSMutableDictionary *retval = [[NSMutableDictionary alloc] init];
+
+        for (id key in dictionary) {
+            NSDictionary *value = dictionary[key];
+
+            for (id valueKey in value) {
+                retval[valueKey] = value[valueKey];
+            }
+        }
+        return retval;
+    } optimised:^id{
+        return [dictionary KQS_flatten];
+    }];
+}
+- (void)checkDeepFlatten {
+    NSDictionary *tree = [self randomTreeWithDepth:3];
+    // the alphabet of randomString contains x, so with it as the separator different key paths often join to the same string
+    NSString *separator = [self randomChance:0.5] ? @"." : @"x";
+    KQSDictionaryConflictPolicy conflictPolicy = (KQSDictionaryConflictPolicy)[self randomBelow:3];
+    NSDictionary *keyPaths = [self randomKeyPathsWithSeparator:separator];
+    NSUInteger stopAfter = 1 + [self randomBelow:32];
+    NSDictionary *input = @{@"dictionary": tree, @"separator": separator, @"conflictPolicy": @(conflictPolicy), @"stopAfter": @(stopAfter)};
+
+    [self checkOperation:@"NSDictionary.KQS_eachLeaf:" input:input reference:^id{
+        NSMutableArray *retval = [[NSMutableArray alloc] init];
+
+        KQSDifferentialHarnessReferenceLeaves(tree, @[], retval);
+
+        return retval;
+    } optimised:^id{
+        NSMutableArray *retval = [[NSMutableArray alloc] init];
+
+        [tree KQS_eachLeaf:^(NSArray *keyPath, id value, BOOL *stop) {
+            [retval addObject:@[[keyPath copy],value]];
+        }];
+
+        return retval;
+    }];
+    [self checkOperation:@"NSDictionary.KQS_eachLeaf: (stop)" input:input reference:^id{
+        NSMutableArray *retval = [[NSMutableArray alloc] init];
+
+        KQSDifferentialHarnessReferenceLeaves(tree, @[], retval);
+
+        return [retval subarrayWithRange:NSMakeRange(0, MIN(retval.count, stopAfter))];
+    } optimised:^id{
+        NSMutableArray *retval = [[NSMutableArray alloc] init];
+
+        [tree KQS_eachLeaf:^(NSArray *keyPath, id value, BOOL *stop) {
+            [retval addObject:@[[keyPath copy],value]];
+
+            *stop = retval.count == stopAfter;
+        }];
+
+        return retval;
+    }];
+    [self checkOperation:@"NSDictionary.KQS_flattenDeepWithSeparator:conflictPolicy:" input:input reference:^id{
+        NSMutableArray<NSArray *> *leaves = [[NSMutableArray alloc] init];
+        NSMutableDictionary *retval = [[NSMutableDictionary alloc] init];
+
+        KQSDifferentialHarnessReferenceLeaves(tree, @[], leaves);
+
+        for (NSArray *leaf in leaves) {
+            NSMutableArray<NSString *> *components = [[NSMutableArray alloc] init];
+
+            for (id key in leaf.firstObject) {
+                [components addObject:[key isKindOfClass:[NSString class]] ? key : [key description]];
+            }
+
+            NSString *joinedKey = [components componentsJoinedByString:separator];
+
+            if (retval[joinedKey] != nil) {
+                if (conflictPolicy == KQSDictionaryConflictPolicyThrow) {
+                    [NSException raise:NSInvalidArgumentException format:@"duplicate key path %@",joinedKey];
+                }
+                else if (conflictPolicy == KQSDictionaryConflictPolicyFirstWins) {
+                    continue;
+                }
+            }
+
+            retval[joinedKey] = leaf.lastObject;
+        }
+        return retval;
+    } optimised:^id{
+        return [tree KQS_flattenDeepWithSeparator:separator conflictPolicy:conflictPolicy];
+    }];
+
+    input = @{@"dictionary": keyPaths, @"separator": separator, @"conflictPolicy": @(conflictPolicy)};
+
+    [self checkOperation:@"NSDictionary.KQS_unflattenWithSeparator:conflictPolicy:" input:input reference:^id{
+        NSMutableDictionary *retval = [[NSMutableDictionary alloc] init];
+        // the nested dictionaries created here, told apart from leaf values that are dictionaries by identity
+        NSHashTable *containers = [[NSHashTable alloc] initWithOptions:NSPointerFunctionsStrongMemory|NSPointerFunctionsObjectPointerPersonality capacity:0];
+
+        [containers addObject:retval];
+
+        for (id key in keyPaths) {
+            NSArray *components = [key isKindOfClass:[NSString class]] ? [key componentsSeparatedByString:separator] : @[key];
+            NSMutableDictionary *container = retval;
+
+            for (NSUInteger i=0; i<components.count; i++) {
+                id component = components[i];
+                id existing = container[component];
+                BOOL last = i == components.count - 1;
+
+                // descend into a nested dictionary, or add a new leaf or nested dictionary
+                if (!last &&
+                    [containers containsObject:existing]) {
+
+                    container = existing;
+                    continue;
+                }
+                // anything else already at this key path is a conflict between a leaf and a nested dictionary
+                if (existing != nil) {
+                    if (conflictPolicy == KQSDictionaryConflictPolicyThrow) {
+                        [NSException raise:NSInvalidArgumentException format:@"conflicting key path %@",key];
+                    }
+                    else if (conflictPolicy == KQSDictionaryConflictPolicyFirstWins) {
+                        break;
+                    }
+                }
+
+                if (last) {
+                    container[component] = keyPaths[key];
+                }
+                else {
+                    NSMutableDictionary *child = [[NSMutableDictionary alloc] init];
+
+                    [containers addObject:child];
+
+                    container[component] = child;
+                    container = child;
+                }
+            }
+        }
+        return KQSDifferentialHarnessReferenceFreeze(retval, containers);
+    } optimised:^id{
+        return [keyPaths KQS_unflattenWithSeparator:separator conflictPolicy:conflictPolicy];
+    }];
+}
+- (void)checkKeyPaths {
+    NSArray *array = [self randomRecordsWithCount:[self randomCount]];
+    NSOrderedSet *orderedSet = [NSOrderedSet orderedSetWithArray:array];
+    NSSet *set = [NSSet setWithArray:array];
+    NSMutableDictionary *dictionary = [[NSMutableDictionary alloc] init];
+    NSString *keyPath = self.keyPaths[[self randomBelow:self.keyPaths.count]];
+    BOOL ascending = [self randomChance:0.5];
+    id value = nil;
+
+    for (NSUInteger i=0; i<array.count; i++) {
+        dictionary[@(i)] = array[i];
+    }
+
+    // compare against a value that is present most of the time
+    if (array.count > 0 &&
+        [self randomChance:0.8]) {
+
+        value = [array[[self randomBelow:array.count]] valueForKeyPath:keyPath];
+    }
+
+    id(^read)(id) = ^id(id object) {
+        return [object valueForKeyPath:keyPath] ?: [NSNull null];
+    };
+    NSComparator compare = ^NSComparisonResult(id first, id second) {
+        id firstValue = read(first), secondValue = read(second);
+        NSComparisonResult result;
+
+        if (firstValue == secondValue) {
+            result = NSOrderedSame;
+        }
+        else if (firstValue == [NSNull null]) {
+            result = NSOrderedAscending;
+        }
+        else if (secondValue == [NSNull null]) {
+            result = NSOrderedDescending;
+        }
+        else {
+            result = [firstValue compare:secondValue];
+        }
+
+        return ascending ? result : (NSComparisonResult)-result;
+    };
+    // the first object with the greatest or least value, skipping nil and NSNull
+    id(^extreme)(id<NSFastEnumeration>, NSComparisonResult) = ^id(id<NSFastEnumeration> objects, NSComparisonResult order) {
+        id retval = nil, best = nil;
+
+        for (id object in objects) {
+            id objectValue = read(object);
+
+            if (objectValue == [NSNull null]) {
+                continue;
+            }
+            if (best == nil ||
+                [objectValue compare:best] == order) {
+
+                retval = object;
+                best = objectValue;
+            }
+        }
+        return retval;
+    };
+    // integral values are summed exactly, the scores are multiples of a quarter so their sum is exact in any order as well
+    NSNumber *(^sum)(id<NSFastEnumeration>) = ^NSNumber *(id<NSFastEnumeration> objects) {
+        long long integerSum = 0;
+        double doubleSum = 0.0;
+        BOOL integral = YES;
+
+        for (id object in objects) {
+            NSNumber *number = [object valueForKeyPath:keyPath];
+
+            if (![number isKindOfClass:[NSNumber class]]) {
+                continue;
+            }
+
+            integerSum += number.longLongValue;
+            doubleSum += number.doubleValue;
+            integral = integral && KQSDifferentialHarnessKindOfNumber(number) == KQSDifferentialHarnessNumberKindIntegral;
+        }
+        return integral ? @(integerSum) : @(doubleSum);
+    };
+    KQSDifferentialHarnessEqualBlock identical = ^BOOL(id expected, id actual) {
+        return expected == actual;
+    };
+    // sets and dictionaries have no order of their own, so objects with the same value may be chosen or sorted either way
+    KQSDifferentialHarnessEqualBlock sameValue = ^BOOL(id expected, id actual) {
+        return expected == nil ? actual == nil : actual != nil && compare(expected, actual) == NSOrderedSame;
+    };
+    BOOL(^sameValues)(NSArray *, NSArray *) = ^BOOL(NSArray *expected, NSArray *actual) {
+        if (![actual isKindOfClass:[NSArray class]] ||
+            actual.count != expected.count) {
+
+            return NO;
+        }
+
+        for (NSUInteger i=0; i<expected.count; i++) {
+            if (compare(expected[i], actual[i]) != NSOrderedSame) {
+                return NO;
+            }
+        }
+        return YES;
+    };
+    NSDictionary *input = @{@"collection": array, @"keyPath": keyPath, @"value": value ?: [NSNull null]};
+
+    [self checkOperation:@"NSArray.KQS_pluck:" input:input reference:^id{
+        NSMutableArray *retval = [[NSMutableArray alloc] init];
+
+        for (id object in array) {
+            [retval addObject:read(object)];
+        }
+        return retval;
+    } optimised:^id{
+        return [array KQS_pluck:keyPath];
+    }];
+    [self checkOperation:@"NSArray.KQS_filterWhereKeyPath:equals:" input:input reference:^id{
+        NSMutableArray *retval = [[NSMutableArray alloc] init];
+
+        for (id object in array) {
+            if ([read(object) isEqual:value ?: [NSNull null]]) {
+                [retval addObject:object];
+            }
+        }
+        return retval;
+    } optimised:^id{
+        return [array KQS_filterWhereKeyPath:keyPath equals:value];
+    }];
+    [self checkOperation:@"NSArray.KQS_sortByKeyPath:ascending:" input:input reference:^id{
+        return [array sortedArrayWithOptions:NSSortStable usingComparator:compare];
+    } optimised:^id{
+        return [array KQS_sortByKeyPath:keyPath ascending:ascending];
+    }];
+    [self checkOperation:@"NSArray.KQS_sumOfKeyPath:" input:input reference:^id{
+        return sum(array);
+    } optimised:^id{
+        return [array KQS_sumOfKeyPath:keyPath];
+    } equal:KQSDifferentialHarnessNumbersEqual(0.0)];
+    [self checkOperation:@"NSArray.KQS_maximumByKeyPath:" input:input reference:^id{
+        return extreme(array, NSOrderedDescending);
+    } optimised:^id{
+        return [array KQS_maximumByKeyPath:keyPath];
+    } equal:identical];
+    [self checkOperation:@"NSArray.KQS_minimumByKeyPath:" input:input reference:^id{
+        return extreme(array, NSOrderedAscending);
+    } optimised:^id{
+        return [array KQS_minimumByKeyPath:keyPath];
+    } equal:identical];
+    [self checkOperation:@"NSArray.KQS_groupByKeyPath:" input:input reference:^id{
+        NSMutableDictionary *retval = [[NSMutableDictionary alloc] init];
+
+        for (id object in array) {
+            id key = read(object);
+            NSMutableArray *group = retval[key];
+
+            if (group == nil) {
+                group = [[NSMutableArray alloc] init];
+                retval[key] = group;
+            }
+
+            [group addObject:object];
+        }
+        return retval;
+    } optimised:^id{
+        return [array KQS_groupByKeyPath:keyPath];
+    }];
+    [self checkOperation:@"NSOrderedSet.KQS_pluck:" input:input reference:^id{
+        NSMutableOrderedSet *retval = [[NSMutableOrderedSet alloc] init];
+
+        for (id object in orderedSet) {
+            [retval addObject:read(object)];
+        }
+        return retval;
+    } optimised:^id{
+        return [orderedSet KQS_pluck:keyPath];
+    }];
+    [self checkOperation:@"NSOrderedSet.KQS_sortByKeyPath:ascending:" input:input reference:^id{
+        return [NSOrderedSet orderedSetWithArray:[orderedSet.array sortedArrayWithOptions:NSSortStable usingComparator:compare]];
+    } optimised:^id{
+        return [orderedSet KQS_sortByKeyPath:keyPath ascending:ascending];
+    }];
+    [self checkOperation:@"NSOrderedSet.KQS_filterWhereKeyPath:equals:" input:input reference:^id{
+        NSMutableOrderedSet *retval = [[NSMutableOrderedSet alloc] init];
+
+        for (id object in orderedSet) {
+            if ([read(object) isEqual:value ?: [NSNull null]]) {
+                [retval addObject:object];
+            }
+        }
+        return retval;
+    } optimised:^id{
+        return [orderedSet KQS_filterWhereKeyPath:keyPath equals:value];
+    }];
+    [self checkOperation:@"NSOrderedSet.KQS_sumOfKeyPath:" input:input reference:^id{
+        return sum(orderedSet);
+    } optimised:^id{
+        return [orderedSet KQS_sumOfKeyPath:keyPath];
+    } equal:KQSDifferentialHarnessNumbersEqual(0.0)];
+    [self checkOperation:@"NSOrderedSet.KQS_maximumByKeyPath:" input:input reference:^id{
+        return extreme(orderedSet, NSOrderedDescending);
+    } optimised:^id{
+        return [orderedSet KQS_maximumByKeyPath:keyPath];
+    } equal:identical];
+    [self checkOperation:@"NSOrderedSet.KQS_minimumByKeyPath:" input:input reference:^id{
+        return extreme(orderedSet, NSOrderedAscending);
+    } optimised:^id{
+        return [orderedSet KQS_minimumByKeyPath:keyPath];
+    } equal:identical];
+    [self checkOperation:@"NSOrderedSet.KQS_groupByKeyPath:" input:input reference:^id{
+        NSMutableDictionary *retval = [[NSMutableDictionary alloc] init];
+
+        for (id object in orderedSet) {
+            id key = read(object);
+            NSMutableOrderedSet *group = retval[key];
+
+            if (group == nil) {
+                group = [[NSMutableOrderedSet alloc] init];
+                retval[key] = group;
+            }
+
+            [group addObject:object];
+        }
+        return retval;
+    } optimised:^id{
+        return [orderedSet KQS_groupByKeyPath:keyPath];
+    }];
+    [self checkOperation:@"NSSet.KQS_pluck:" input:input reference:^id{
+        NSMutableSet *retval = [[NSMutableSet alloc] init];
+
+        for (id object in set) {
+            [retval addObject:read(object)];
+        }
+        return retval;
+    } optimised:^id{
+        return [set KQS_pluck:keyPath];
+    }];
+    [self checkOperation:@"NSSet.KQS_filterWhereKeyPath:equals:" input:input reference:^id{
+        NSMutableSet *retval = [[NSMutableSet alloc] init];
+
+        for (id object in set) {
+            if ([read(object) isEqual:value ?: [NSNull null]]) {
+                [retval addObject:object];
+            }
+        }
+        return retval;
+    } optimised:^id{
+        return [set KQS_filterWhereKeyPath:keyPath equals:value];
+    }];
+    [self checkOperation:@"NSSet.KQS_sortByKeyPath:ascending:" input:input reference:^id{
+        return [set.allObjects sortedArrayWithOptions:NSSortStable usingComparator:compare];
+    } optimised:^id{
+        return [set KQS_sortByKeyPath:keyPath ascending:ascending];
+    } equal:^BOOL(NSArray *expected, NSArray *actual) {
+        return sameValues(expected, actual) && [[NSSet setWithArray:actual] isEqualToSet:set];
+    }];
+    [self checkOperation:@"NSSet.KQS_sumOfKeyPath:" input:input reference:^id{
+        return sum(set);
+    } optimised:^id{
+        return [set KQS_sumOfKeyPath:keyPath];
+    } equal:KQSDifferentialHarnessNumbersEqual(0.0)];
+    [self checkOperation:@"NSSet.KQS_maximumByKeyPath:" input:input reference:^id{
+        return extreme(set, NSOrderedDescending);
+    } optimised:^id{
+        return [set KQS_maximumByKeyPath:keyPath];
+    } equal:sameValue];
+    [self checkOperation:@"NSSet.KQS_minimumByKeyPath:" input:input reference:^id{
+        return extreme(set, NSOrderedAscending);
+    } optimised:^id{
+        return [set KQS_minimumByKeyPath:keyPath];
+    } equal:sameValue];
+    [self checkOperation:@"NSSet.KQS_groupByKeyPath:" input:input reference:^id{
+        NSMutableDictionary *retval = [[NSMutableDictionary alloc] init];
+
+        for (id object in set) {
+            id key = read(object);
+            NSMutableSet *group = retval[key];
+
+            if (group == nil) {
+                group = [[NSMutableSet alloc] init];
+                retval[key] = group;
+            }
+
+            [group addObject:object];
+        }
+        return retval;
+    } optimised:^id{
+        return [set KQS_groupByKeyPath:keyPath];
+    }];
+    [self checkOperation:@"NSDictionary.KQS_pluck:" input:input reference:^id{
+        NSMutableDictionary *retval = [[NSMutableDictionary alloc] init];
+
+        for (id key in dictionary) {
+            retval[key] = read(dictionary[key]);
+        }
+        return retval;
+    } optimised:^id{
+        return [dictionary KQS_pluck:keyPath];
+    }];
+    [self checkOperation:@"NSDictionary.KQS_filterWhereKeyPath:equals:" input:input reference:^id{
+        NSMutableDictionary *retval = [[NSMutableDictionary alloc] init];
+
+        for (id key in dictionary) {
+            if ([read(dictionary[key]) isEqual:value ?: [NSNull null]]) {
+                retval[key] = dictionary[key];
+            }
+        }
+        return retval;
+    } optimised:^id{
+        return [dictionary KQS_filterWhereKeyPath:keyPath equals:value];
+    }];
+    // the keys are sorted by the values they map to
+    [self checkOperation:@"NSDictionary.KQS_sortByKeyPath:ascending:" input:input reference:^id{
+        return [dictionary keysSortedByValueWithOptions:NSSortStable usingComparator:compare];
+    } optimised:^id{
+        return [dictionary KQS_sortByKeyPath:keyPath ascending:ascending];
+    } equal:^BOOL(NSArray *expected, NSArray *actual) {
+        return [actual isKindOfClass:[NSArray class]] &&
+        actual.count == dictionary.count &&
+        [[NSSet setWithArray:actual] isEqualToSet:[NSSet setWithArray:dictionary.allKeys]] &&
+        sameValues([dictionary objectsForKeys:expected notFoundMarker:[NSNull null]], [dictionary objectsForKeys:actual notFoundMarker:[NSNull null]]);
+    }];
+    [self checkOperation:@"NSDictionary.KQS_sumOfKeyPath:" input:input reference:^id{
+        return sum(dictionary.objectEnumerator);
+    } optimised:^id{
+        return [dictionary KQS_sumOfKeyPath:keyPath];
+    } equal:KQSDifferentialHarnessNumbersEqual(0.0)];
+    [self checkOperation:@"NSDictionary.KQS_maximumByKeyPath:" input:input reference:^id{
+        return extreme(dictionary.objectEnumerator, NSOrderedDescending);
+    } optimised:^id{
+        return [dictionary KQS_maximumByKeyPath:keyPath];
+    } equal:sameValue];
+    [self checkOperation:@"NSDictionary.KQS_minimumByKeyPath:" input:input reference:^id{
+        return extreme(dictionary.objectEnumerator, NSOrderedAscending);
+    } optimised:^id{
+        return [dictionary KQS_minimumByKeyPath:keyPath];
+    } equal:sameValue];
+    [self checkOperation:@"NSDictionary.KQS_groupByKeyPath:" input:input reference:^id{
+        NSMutableDictionary *retval = [[NSMutableDictionary alloc] init];
+
+        for (id key in dictionary) {
+            id groupKey = read(dictionary[key]);
+            NSMutableDictionary *group = retval[groupKey];
+
+            if (group == nil) {
+                group = [[NSMutableDictionary alloc] init];
+                retval[groupKey] = group;
+            }
+
+            group[key] = dictionary[key];
+        }
+        return retval;
+    } optimised:^id{
+        return [dictionary KQS_groupByKeyPath:keyPath];
+    }];
+}
+- (void)checkAsync {
+    // kept small, every item is dispatched separately and some of them are delayed
+    NSArray *array = [self randomArrayWithCount:[self randomBelow:129] depth:1];
+    NSOrderedSet *orderedSet = [NSOrderedSet orderedSetWithArray:array];
+    NSDictionary *dictionary = [self randomDictionaryWithCount:[self randomBelow:129] depth:1];
+    // values <= 0 use the active processor count
+    NSInteger maxConcurrency = (NSInteger)[self randomBelow:10] - 1;
+    NSUInteger salt = (NSUInteger)[self nextRandom];
+    // completes synchronously, from another thread or after a short delay, so the items finish out of order
+    void(^deliver)(NSUInteger, dispatch_block_t) = ^(NSUInteger hash, dispatch_block_t block) {
+        dispatch_queue_t queue = dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0);
+
+        switch ((hash ^ salt) % 3) {
+            case 0:
+                block();
+                break;
+            case 1:
+                dispatch_async(queue, block);
+                break;
+            default:
+                dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)((hash % 4) * 100 * NSEC_PER_USEC)), queue, block);
+                break;
+        }
+    };
+    id(^indexed)(id, NSInteger) = ^id(id object, NSInteger index) {
+        return ([object hash] + (NSUInteger)index) % 3 == 0 ? nil : @[object,@(index % 4)];
+    };
+    id(^pairs)(id, id) = ^id(id key, id value) {
+        return [key hash] % 3 == 0 ? nil : @[key,value];
+    };
+    BOOL(^passes)(id, NSInteger) = ^BOOL(id object, NSInteger index) {
+        return (([object hash] ^ (NSUInteger)index) & 1) == 0;
+    };
+    BOOL(^pairPasses)(id, id) = ^BOOL(id key, id value) {
+        return (([key hash] ^ [value hash]) & 1) == 0;
+    };
+    NSDictionary *input = @{@"collection": array, @"maxConcurrency": @(maxConcurrency)};
+
+    [self checkOperation:@"NSArray.KQS_asyncMap:maxConcurrency:completion:" input:input reference:^id{
+        NSMutableArray *retval = [[NSMutableArray alloc] init];
+
+        for (NSUInteger i=0; i<array.count; i++) {
+            [retval addObject:indexed(array[i],i) ?: [NSNull null]];
+        }
+        return retval;
+    } optimised:^id{
+        return [self waitForAsyncOperation:^(void (^finish)(id)) {
+            [array KQS_asyncMap:^(id object, NSInteger index, void (^completion)(id)) {
+                deliver([object hash] + (NSUInteger)index, ^{
+                    completion(indexed(object,index));
+                });
+            } maxConcurrency:maxConcurrency completion:^(NSArray *result, NSError *error) {
+                finish(result ?: error);
+            }];
+        }];
+    }];
+    [self checkOperation:@"NSArray.KQS_asyncFilter:maxConcurrency:completion:" input:input reference:^id{
+        NSMutableArray *retval = [[NSMutableArray alloc] init];
+
+        for (NSUInteger i=0; i<array.count; i++) {
+            if (passes(array[i],i)) {
+                [retval addObject:array[i]];
+            }
+        }
+        return retval;
+    } optimised:^id{
+        return [self waitForAsyncOperation:^(void (^finish)(id)) {
+            [array KQS_asyncFilter:^(id object, NSInteger index, void (^completion)(BOOL)) {
+                deliver([object hash] + (NSUInteger)index, ^{
+                    completion(passes(object,index));
+                });
+            } maxConcurrency:maxConcurrency completion:^(NSArray *result, NSError *error) {
+                finish(result ?: error);
+            }];
+        }];
+    }];
+
+    input = @{@"collection": orderedSet, @"maxConcurrency": @(maxConcurrency)};
+
+    [self checkOperation:@"NSOrderedSet.KQS_asyncMap:maxConcurrency:completion:" input:input reference:^id{
+        NSMutableOrderedSet *retval = [[NSMutableOrderedSet alloc] init];
+
+        for (NSUInteger i=0; i<orderedSet.count; i++) {
+            [retval addObject:indexed(orderedSet[i],i) ?: [NSNull null]];
+        }
+        return retval;
+    } optimised:^id{
+        return [self waitForAsyncOperation:^(void (^finish)(id)) {
+            [orderedSet KQS_asyncMap:^(id object, NSInteger index, void (^completion)(id)) {
+                deliver([object hash] + (NSUInteger)index, ^{
+                    completion(indexed(object,index));
+                });
+            } maxConcurrency:maxConcurrency completion:^(NSOrderedSet *result, NSError *error) {
+                finish(result ?: error);
+            }];
+        }];
+    }];
+    [self checkOperation:@"NSOrderedSet.KQS_asyncFilter:maxConcurrency:completion:" input:input reference:^id{
+        NSMutableOrderedSet *retval = [[NSMutableOrderedSet alloc] init];
+
+        for (NSUInteger i=0; i<orderedSet.count; i++) {
+            if (passes(orderedSet[i],i)) {
+                [retval addObject:orderedSet[i]];
+            }
+        }
+        return retval;
+    } optimised:^id{
+        return [self waitForAsyncOperation:^(void (^finish)(id)) {
+            [orderedSet KQS_asyncFilter:^(id object, NSInteger index, void (^completion)(BOOL)) {
+                deliver([object hash] + (NSUInteger)index, ^{
+                    completion(passes(object,index));
+                });
+            } maxConcurrency:maxConcurrency completion:^(NSOrderedSet *result, NSError *error) {
+                finish(result ?: error);
+            }];
+        }];
+    }];
+
+    input = @{@"collection": dictionary, @"maxConcurrency": @(maxConcurrency)};
+
+    [self checkOperation:@"NSDictionary.KQS_asyncMap:maxConcurrency:completion:" input:input reference:^id{
+        NSMutableDictionary *retval = [[NSMutableDictionary alloc] init];
+
+        for (id key in dictionary) {
+            retval[key] = pairs(key,dictionary[key]) ?: [NSNull null];
+        }
+        return retval;
+    } optimised:^id{
+        return [self waitForAsyncOperation:^(void (^finish)(id)) {
+            [dictionary KQS_asyncMap:^(id key, id value, void (^completion)(id)) {
+                deliver([key hash], ^{
+                    completion(pairs(key,value));
+                });
+            } maxConcurrency:maxConcurrency completion:^(NSDictionary *result, NSError *error) {
+                finish(result ?: error);
+            }];
+        }];
+    }];
+    [self checkOperation:@"NSDictionary.KQS_asyncFilter:maxConcurrency:completion:" input:input reference:^id{
+        NSMutableDictionary *retval = [[NSMutableDictionary alloc] init];
+
+        for (id key in dictionary) {
+            if (pairPasses(key,dictionary[key])) {
+                retval[key] = dictionary[key];
+            }
+        }
+        return retval;
+    } optimised:^id{
+        return [self waitForAsyncOperation:^(void (^finish)(id)) {
+            [dictionary KQS_asyncFilter:^(id key, id value, void (^completion)(BOOL)) {
+                deliver([key hash], ^{
+                    completion(pairPasses(key,value));
+                });
+            } maxConcurrency:maxConcurrency completion:^(NSDictionary *result, NSError *error) {
+                finish(result ?: error);
+            }];
+        }];
+    }];
+}
+- (void)checkPersistentVector {
+    NSArray *array = [self randomArrayWithCount:[self randomCount] depth:1];
+    NSArray *other = [self randomArrayWithCount:[self randomBelow:64] depth:1];
+    KQSPersistentVector *vector = [KQSPersistentVector vectorWithArray:array];
+    id object = [self randomObjectWithDepth:1];
+    NSUInteger index = [self randomBelow:array.count];
+    NSUInteger location = [self randomBelow:array.count + 1];
+    NSRange range = NSMakeRange(location, [self randomBelow:array.count - location + 1]);
+    // includes counts past the end and, occasionally, a negative count
+    NSInteger count = [self randomChance:0.1] ? -1 : (NSInteger)[self randomBelow:array.count + 6];
+    id(^transform)(id, NSInteger) = ^id(id value, NSInteger valueIndex) {
+        return ([value hash] + (NSUInteger)valueIndex) % 3 == 0 ? nil : @[value];
+    };
+    KQSDifferentialHarnessEqualBlock equal = ^BOOL(NSArray *expected, KQSPersistentVector *actual) {
+        return [actual isKindOfClass:[KQSPersistentVector class]] && [actual.array isEqualToArray:expected];
+    };
+    NSDictionary *input = @{@"collection": array, @"other": other, @"object": object, @"index": @(index), @"range": NSStringFromRange(range), @"count": @(count)};
+
+    [self checkOperation:@"KQSPersistentVector.vectorByAddingObject:" input:input reference:^id{
+        return [array arrayByAddingObject:object];
+    } optimised:^id{
+        return [vector vectorByAddingObject:object];
+    } equal:equal];
+    [self checkOperation:@"KQSPersistentVector.vectorByAddingObjectsFromArray:" input:input reference:^id{
+        return [array arrayByAddingObjectsFromArray:other];
+    } optimised:^id{
+        return [vector vectorByAddingObjectsFromArray:other];
+    } equal:equal];
+    if (array.count > 0) {
+        [self checkOperation:@"KQSPersistentVector.vectorByReplacingObjectAtIndex:withObject:" input:input reference:^id{
+            NSMutableArray *retval = [array mutableCopy];
+
+            retval[index] = object;
+
+            return retval;
+        } optimised:^id{
+            return [vector vectorByReplacingObjectAtIndex:index withObject:object];
+        } equal:equal];
+    }
+    [self checkOperation:@"KQSPersistentVector.subvectorWithRange:" input:input reference:^id{
+        return [array subarrayWithRange:range];
+    } optimised:^id{
+        return [vector subvectorWithRange:range];
+    } equal:equal];
+    [self checkOperation:@"KQSPersistentVector.KQS_take:" input:input reference:^id{
+        return [array KQS_take:count];
+    } optimised:^id{
+        return [vector KQS_take:count];
+    } equal:equal];
+    [self checkOperation:@"KQSPersistentVector.KQS_drop:" input:input reference:^id{
+        return [array KQS_drop:count];
+    } optimised:^id{
+        return [vector KQS_drop:count];
+    } equal:equal];
+    [self checkOperation:@"KQSPersistentVector.KQS_map:" input:input reference:^id{
+        NSMutableArray *retval = [[NSMutableArray alloc] init];
+
+        for (NSUInteger i=0; i<array.count; i++) {
+            [retval addObject:transform(array[i],i) ?: [NSNull null]];
+        }
+        return retval;
+    } optimised:^id{
+        return [vector KQS_map:transform];
+    } equal:equal];
+}
+- (void)checkSketches {
+    NSArray *array = [self randomScalarsWithCount:[self randomLargeCount]];
+    BOOL concurrent = [self randomChance:0.5];
+
+    [self checkOperation:@"NSArray.KQS_bloomFilterWithFalsePositiveRate:concurrent:" input:array reference:^id{
+        NSSet *set = [NSSet setWithArray:array];
+
+        for (id object in array) {
+            if (![set containsObject:object]) {
+                return @NO;
+            }
+        }
+        return @YES;
+    } optimised:^id{
+        // a bloom filter never reports a false negative
+        KQSBloomFilter *bloomFilter = [array KQS_bloomFilterWithFalsePositiveRate:0.01 concurrent:concurrent];
+
+        for (id object in array) {
+            if (![bloomFilter containsObject:object]) {
+                return @NO;
+            }
+        }
+        return @YES;
+    }];
+    [self checkOperation:@"NSArray.KQS_hyperLogLogWithPrecision:concurrent:" input:array reference:^id{
+        return @([NSSet setWithArray:array].count);
+    } optimised:^id{
+        return @([array KQS_hyperLogLogWithPrecision:KQSHyperLogLogDefaultPrecision concurrent:concurrent].count);
+    } equal:^BOOL(NSNumber *expected, NSNumber *actual) {
+        // six standard errors at the default precision, plus a little slack for tiny counts
+        return fabs(expected.doubleValue - actual.doubleValue) <= 6.0 * 1.04 / sqrt((double)(1 << KQSHyperLogLogDefaultPrecision)) * expected.doubleValue + 2.0;
+    }];
+    // merging the registers of each chunk must give exactly the serial estimate
+    [self checkOperation:@"NSArray.KQS_hyperLogLogWithPrecision:concurrent: (concurrent vs serial)" input:array reference:^id{
+        return @([array KQS_hyperLogLogWithPrecision:KQSHyperLogLogDefaultPrecision concurrent:NO].count);
+    } optimised:^id{
+        return @([array KQS_hyperLogLogWithPrecision:KQSHyperLogLogDefaultPrecision concurrent:YES].count);
+    }];
+}
+- (void)checkSample {
+    NSArray *array = [self randomScalarsWithCount:[self randomLargeCount]];
+    NSInteger count = (NSInteger)[self randomBelow:MIN(array.count, 64) + 2];
+    uint64_t seed = [self nextRandom];
+    NSDictionary *input = @{@"collection": array, @"count": @(count), @"seed": @(seed)};
+
+    // the reference is the copy, shuffle and take that KQS_sample: replaces, which chooses different objects, so only the shape of the results is compared
+    [self checkOperation:@"NSArray.KQS_sample:random:" input:input reference:^id{
+        NSMutableArray *retval = [array mutableCopy];
+
+        [retval KQS_shuffleWithRandom:[[KQSRandom alloc] initWithSeed:seed]];
+
+        return [retval KQS_take:count];
+    } optimised:^id{
+        return [array KQS_sample:count random:[[KQSRandom alloc] initWithSeed:seed]];
+    } equal:^BOOL(NSArray *expected, NSArray *actual) {
+        if (expected.count != actual.count) {
+            return NO;
+        }
+
+        // no index may be chosen twice, so each object appears at most as often as it does in the array
+        NSCountedSet *remaining = [[NSCountedSet alloc] initWithArray:array];
+
+        for (id object in actual) {
+            if ([remaining countForObject:object] == 0) {
+                return NO;
+            }
+
+            [remaining removeObject:object];
+        }
+        return YES;
+    }];
+}
+#pragma mark Random
+- (uint64_t)nextRandom {
+    // splitmix64
+    uint64_t retval = (_state += 0x9E3779B97F4A7C15ULL);
+
+    retval = (retval ^ (retval >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    retval = (retval ^ (retval >> 27)) * 0x94D049BB133111EBULL;
+
+    return retval ^ (retval >> 31);
+}
+- (NSUInteger)randomBelow:(NSUInteger)bound {
+    return bound == 0 ? 0 : (NSUInteger)([self nextRandom] % bound);
+}
+- (double)randomDouble {
+    return (double)([self nextRandom] >> 11) * 0x1.0p-53;
+}
+- (BOOL)randomChance:(double)chance {
+    return [self randomDouble] < chance;
+}
+// mostly small collections, with empty, single object and a few large ones
+- (NSUInteger)randomCount {
+    double roll = [self randomDouble];
+
+    if (roll < 0.1) {
+        return 0;
+    }
+    else if (roll < 0.2) {
+        return 1;
+    }
+    else if (roll < 0.8) {
+        return 2 + [self randomBelow:63];
+    }
+    else if (roll < 0.97) {
+        return 65 + [self randomBelow:960];
+    }
+    return 1025 + [self randomBelow:15000];
+}
+// occasionally large enough for the concurrent paths of the summation and sketches to split into chunks
+- (NSUInteger)randomLargeCount {
+    return [self randomChance:0.05] ? 32768 + [self randomBelow:65536] : [self randomCount];
+}
+- (NSNumber *)randomInteger {
+    return @((NSInteger)[self randomBelow:2001] - 1000);
+}
+- (NSNumber *)randomFloatingPoint {
+    // spans twenty orders of magnitude so the sums see cancellation
+    double magnitude = pow(10.0, (double)[self randomBelow:21] - 10.0);
+
+    return @(([self randomDouble] * 2.0 - 1.0) * magnitude);
+}
+- (NSDecimalNumber *)randomDecimal {
+    return [NSDecimalNumber decimalNumberWithMantissa:[self randomBelow:100000] exponent:-(short)[self randomBelow:4] isNegative:[self randomChance:0.5]];
+}
+- (NSString *)randomString {
+    // a small alphabet so that equal strings are common
+    static char const kAlphabet[] = "abcxyz";
+    NSUInteger length = [self randomBelow:9];
+    char characters[9];
+
+    for (NSUInteger i=0; i<length; i++) {
+        characters[i] = kAlphabet[[self randomBelow:sizeof(kAlphabet) - 1]];
+    }
+
+    return [[NSString alloc] initWithBytes:characters length:length encoding:NSASCIIStringEncoding];
+}
+- (id)randomObjectWithDepth:(NSUInteger)depth {
+    switch ([self randomBelow:depth > 0 ? 8 : 6]) {
+        case 0:
+            return [self randomInteger];
+        case 1:
+            return [self randomFloatingPoint];
+        case 2:
+            return [self randomDecimal];
+        case 3:
+        case 4:
+            return [self randomString];
+        case 5:
+            return [NSNull null];
+        case 6:
+            return [self randomArrayWithCount:[self randomBelow:5] depth:depth - 1];
+        default:
+            return [self randomDictionaryWithCount:[self randomBelow:5] depth:depth - 1];
+    }
+}
+- (NSArray *)randomArrayWithCount:(NSUInteger)count depth:(NSUInteger)depth {
+    NSMutableArray *retval = [[NSMutableArray alloc] initWithCapacity:count];
+
+    for (NSUInteger i=0; i<count; i++) {
+        [retval addObject:[self randomObjectWithDepth:depth]];
+    }
+
+    return [retval copy];
+}
+- (NSDictionary *)randomDictionaryWithCount:(NSUInteger)count depth:(NSUInteger)depth {
+    NSMutableDictionary *retval = [[NSMutableDictionary alloc] initWithCapacity:count];
+
+    for (NSUInteger i=0; i<count; i++) {
+        // integer keys keep large dictionaries from running out of distinct strings
+        id<NSCopying> key = [self randomChance:0.5] ? [self randomString] : [self randomInteger];
+
+        retval[key] = [self randomObjectWithDepth:depth];
+    }
+
+    return [retval copy];
+}
+// integers and strings only, whose hashes are consistent with isEqual: across classes, for the sketches
+- (NSArray *)randomScalarsWithCount:(NSUInteger)count {
+    NSMutableArray *retval = [[NSMutableArray alloc] initWithCapacity:count];
+
+    for (NSUInteger i=0; i<count; i++) {
+        [retval addObject:[self randomChance:0.5] ? @((NSInteger)[self randomBelow:count * 2 + 1]) : [self randomString]];
+    }
+
+    return [retval copy];
+}
+// the first number decides how KQS_sum adds, decimals are never mixed with other numbers
+- (NSArray<NSNumber *> *)randomNumbersWithCount:(NSUInteger)count {
+    NSMutableArray *retval = [[NSMutableArray alloc] initWithCapacity:count];
+    BOOL decimal = [self randomChance:0.2];
+
+    for (NSUInteger i=0; i<count; i++) {
+        if (decimal) {
+            [retval addObject:[self randomDecimal]];
+        }
+        else {
+            [retval addObject:[self randomChance:0.5] ? [self randomInteger] : [self randomFloatingPoint]];
+        }
+    }
+
+    return [retval copy];
+}
+// a single kind of number, up to six integers of at most 1000 multiply without overflowing and six decimals fit in the mantissa of NSDecimal
+- (NSArray<NSNumber *> *)randomFactorsWithCount:(NSUInteger)count {
+    NSMutableArray *retval = [[NSMutableArray alloc] initWithCapacity:count];
+    NSUInteger kind = [self randomBelow:3];
+
+    for (NSUInteger i=0; i<count; i++) {
+        switch (kind) {
+            case 0:
+                [retval addObject:[self randomInteger]];
+                break;
+            case 1:
+                [retval addObject:[self randomFloatingPoint]];
+                break;
+            default:
+                [retval addObject:[self randomDecimal]];
+                break;
+        }
+    }
+
+    return [retval copy];
+}
+- (NSArray<NSNumber *> *)randomDoublesWithCount:(NSUInteger)count {
+    NSMutableArray *retval = [[NSMutableArray alloc] initWithCapacity:count];
+
+    for (NSUInteger i=0; i<count; i++) {
+        [retval addObject:[self randomFloatingPoint]];
+    }
+
+    // cancel out a random prefix, which naive summation handles badly
+    if ([self randomChance:0.2]) {
+        NSUInteger prefix = [self randomBelow:count + 1];
+
+        for (NSUInteger i=0; i<prefix; i++) {
+            [retval addObject:@(-[retval[i] doubleValue])];
+        }
+    }
+
+    return [retval copy];
+}
+// integers of up to 45 bits scaled by up to 2^-40, spanning about twenty five orders of magnitude, see KQSDifferentialHarnessExactSum
+- (NSArray<NSNumber *> *)randomSummandsWithCount:(NSUInteger)count {
+    NSMutableArray *retval = [[NSMutableArray alloc] initWithCapacity:count];
+
+    // a long run of one value, whose running sum needs more bits than a double has, makes a plain loop drift
+    if ([self randomChance:0.1]) {
+        NSNumber *value = @(ldexp((double)(([self nextRandom] >> 19) | 1), -[self randomBelow:kKQSDifferentialHarnessSummationScale + 1]));
+
+        for (NSUInteger i=0; i<count; i++) {
+            [retval addObject:value];
+        }
+        return [retval copy];
+    }
+
+    for (NSUInteger i=0; i<count; i++) {
+        double value = ldexp((double)([self nextRandom] >> (19 + [self randomBelow:46])), -(int)[self randomBelow:kKQSDifferentialHarnessSummationScale + 1]);
+
+        [retval addObject:@([self randomChance:0.5] ? -value : value)];
+    }
+
+    // cancel out a random prefix, which naive summation handles badly
+    if ([self randomChance:0.2]) {
+        NSUInteger prefix = [self randomBelow:count + 1];
+
+        for (NSUInteger i=0; i<prefix; i++) {
+            [retval addObject:@(-[retval[i] doubleValue])];
+        }
+    }
+
+    return [retval copy];
+}
+// nested dictionaries whose leaves are never dictionaries themselves, for KQS_eachLeaf: and KQS_flattenDeepWithSeparator:conflictPolicy:
+- (NSDictionary *)randomTreeWithDepth:(NSUInteger)depth {
+    NSUInteger count = [self randomBelow:6];
+    NSMutableDictionary *retval = [[NSMutableDictionary alloc] initWithCapacity:count];
+
+    for (NSUInteger i=0; i<count; i++) {
+        id<NSCopying> key = [self randomChance:0.8] ? [self randomString] : [self randomInteger];
+
+        retval[key] = depth > 0 && [self randomChance:0.4] ? [self randomTreeWithDepth:depth - 1] : [self randomObjectWithDepth:0];
+    }
+
+    return [retval copy];
+}
+// flattened key paths for KQS_unflattenWithSeparator:conflictPolicy:, where one key path is often the prefix of another
+- (NSDictionary *)randomKeyPathsWithSeparator:(NSString *)separator {
+    NSUInteger count = [self randomBelow:24];
+    NSMutableDictionary *retval = [[NSMutableDictionary alloc] initWithCapacity:count];
+
+    for (NSUInteger i=0; i<count; i++) {
+        id<NSCopying> key;
+
+        // keys that are not strings are copied as they are
+        if ([self randomChance:0.1]) {
+            key = [self randomInteger];
+        }
+        else {
+            NSUInteger componentCount = 1 + [self randomBelow:3];
+            NSMutableArray *components = [[NSMutableArray alloc] initWithCapacity:componentCount];
+
+            for (NSUInteger j=0; j<componentCount; j++) {
+                [components addObject:[self randomString]];
+            }
+
+            key = [components componentsJoinedByString:separator];
+        }
+
+        retval[key] = [self randomObjectWithDepth:1];
+    }
+
+    return [retval copy];
+}
+- (id)randomRecordWithDepth:(NSUInteger)depth {
+    NSString *name = [self randomChance:0.1] ? nil : [self randomString];
+    NSInteger age = (NSInteger)[self randomBelow:100];
+    // quarter steps so that equal scores, and therefore the stability of the sorts, are common
+    double score = (double)[self randomBelow:200] / 4.0;
+    BOOL active = [self randomChance:0.5];
+    id child = depth > 0 && [self randomChance:0.5] ? [self randomRecordWithDepth:depth - 1] : nil;
+
+    // dictionaries read through KVC rather than a cached getter
+    if ([self randomChance:0.25]) {
+        NSMutableDictionary *retval = [[NSMutableDictionary alloc] init];
+
+        if (name != nil) {
+            retval[@"name"] = name;
+        }
+        if (child != nil) {
+            retval[@"child"] = child;
+        }
+
+        retval[@"age"] = @(age);
+        retval[@"score"] = @(score);
+        retval[@"active"] = @(active);
+
+        return [retval copy];
+    }
+
+    KQSDifferentialRecord *retval = [[KQSDifferentialRecord alloc] init];
+
+    retval.name = name;
+    retval.age = age;
+    retval.score = score;
+    retval.active = active;
+    retval.child = child;
+
+    return retval;
+}
+- (NSArray *)randomRecordsWithCount:(NSUInteger)count {
+    NSMutableArray *retval = [[NSMutableArray alloc] initWithCapacity:count];
+
+    for (NSUInteger i=0; i<count; i++) {
+        [retval addObject:[self randomRecordWithDepth:1]];
+    }
+
+    return [retval copy];
+}
+
+@end
+
+#ifdef KQS_DIFFERENTIAL_MAIN
+// the entry point used by scripts/differential-linux.sh to run the harness without XCTest
+int main(int argc, const char *argv[]) {
+    @autoreleasepool {
+        KQSDifferentialHarness *harness = [KQSDifferentialHarness harnessWithProcessEnvironment];
+        NSArray<KQSDifferentialResult *> *results = [harness run];
+        int retval = EXIT_SUCCESS;
+
+        fprintf(stdout, "%s", [harness reportForResults:results].UTF8String);
+
+        for (KQSDifferentialResult *result in results) {
+            for (NSString *failure in result.failures) {
+                fprintf(stderr, "%s\n", failure.UTF8String);
+
+                retval = EXIT_FAILURE;
+            }
+        }
+
+        return retval;
+    }
+}
+#endif
@@ -0,0 +1,71 @@
+//
+//  KQSDifferentialHarnessPrivate.h
+//  QuicksilverTests-iOS
+//
+//  Created by William Towe on 10/19/26.
+//  Copyright © 2021 Kosoku Interactive, LLC. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#import "KQSDifferentialHarness.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+typedef id _Nullable (^KQSDifferentialHarnessBlock)(void);
+typedef BOOL (^KQSDifferentialHarnessEqualBlock)(id _Nullable expected, id _Nullable actual);
+
+/**
+ The methods shared between KQSDifferentialHarness.m and the categories that add checks in other languages.
+ */
+@interface KQSDifferentialHarness ()
+
+/**
+ Computes the result of *reference* and *optimised*, times them and records a failure for *name* unless both return equal objects or throw exceptions with the same name.
+
+ @param name The name of the operation
+ @param input The input, included in the failure description
+ @param reference The block returning the reference result
+ @param optimised The block returning the optimised result
+ */
+- (void)checkOperation:(NSString *)name input:(id)input reference:(KQSDifferentialHarnessBlock)reference optimised:(KQSDifferentialHarnessBlock)optimised;
+/**
+ Like checkOperation:input:reference:optimised:, using *equal* to compare the results.
+
+ @param name The name of the operation
+ @param input The input, included in the failure description
+ @param reference The block returning the reference result
+ @param optimised The block returning the optimised result
+ @param equal The block that compares the results
+ */
+- (void)checkOperation:(NSString *)name input:(id)input reference:(KQSDifferentialHarnessBlock)reference optimised:(KQSDifferentialHarnessBlock)optimised equal:(KQSDifferentialHarnessEqualBlock)equal;
+
+- (uint64_t)nextRandom;
+- (NSUInteger)randomBelow:(NSUInteger)bound;
+- (BOOL)randomChance:(double)chance;
+- (NSUInteger)randomCount;
+- (NSArray *)randomArrayWithCount:(NSUInteger)count depth:(NSUInteger)depth;
+- (NSDictionary *)randomDictionaryWithCount:(NSUInteger)count depth:(NSUInteger)depth;
+- (NSArray<NSNumber *> *)randomDoublesWithCount:(NSUInteger)count;
+
+@end
+
+@interface KQSDifferentialHarness (KQSCpp)
+
+/**
+ Checks the templates in KQSCpp.h against naive loops. Lives in KQSDifferentialHarness+KQSCpp.mm because the templates are only visible to Objective-C++.
+ */
+- (void)checkCpp;
+
+@end
+
+NS_ASSUME_NONNULL_END
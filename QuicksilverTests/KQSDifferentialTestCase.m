@@ -0,0 +1,68 @@
+//
+//  KQSDifferentialTestCase.m
+//  QuicksilverTests-iOS
+//
+//  Created by William Towe on 10/19/26.
+//  Copyright © 2021 Kosoku Interactive, LLC. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#import <XCTest/XCTest.h>
+
+#import "KQSDifferentialHarness.h"
+
+@interface KQSDifferentialTestCase : XCTestCase
+
+@end
+
+@implementation KQSDifferentialTestCase
+
+- (void)testReferenceMatchesOptimised {
+    KQSDifferentialHarness *harness = [KQSDifferentialHarness harnessWithProcessEnvironment];
+    NSArray<KQSDifferentialResult *> *results = [harness run];
+    NSMutableArray<NSString *> *failures = [[NSMutableArray alloc] init];
+    
+    XCTAssertGreaterThan(results.count, 0);
+    
+    for (KQSDifferentialResult *result in results) {
+        XCTAssertGreaterThan(result.checkCount, 0, @"%@",result.name);
+        
+        [failures addObjectsFromArray:result.failures];
+    }
+    
+    // the report is only worth reading when something differs
+    if (failures.count > 0) {
+        XCTFail(@"%@\n%@",[failures componentsJoinedByString:@"\n"],[harness reportForResults:results]);
+    }
+}
+- (void)testSameSeedSameResults {
+    KQSDifferentialHarness *first = [[KQSDifferentialHarness alloc] initWithSeed:1 iterations:5];
+    KQSDifferentialHarness *second = [[KQSDifferentialHarness alloc] initWithSeed:1 iterations:5];
+    KQSDifferentialHarness *other = [[KQSDifferentialHarness alloc] initWithSeed:2 iterations:5];
+    NSArray<KQSDifferentialResult *> *firstResults = [first run], *secondResults = [second run];
+    
+    [other run];
+    
+    XCTAssertNotEqual(first.inputFingerprint, (uint64_t)0);
+    XCTAssertEqual(first.inputFingerprint, second.inputFingerprint);
+    XCTAssertNotEqual(first.inputFingerprint, other.inputFingerprint);
+    XCTAssertEqual(firstResults.count, secondResults.count);
+    
+    for (NSUInteger i=0; i<MIN(firstResults.count, secondResults.count); i++) {
+        XCTAssertEqualObjects(firstResults[i].name, secondResults[i].name);
+        XCTAssertEqual(firstResults[i].checkCount, secondResults[i].checkCount);
+        XCTAssertEqualObjects(firstResults[i].failures, secondResults[i].failures);
+    }
+}
+
+@end
@@ -0,0 +1,81 @@
+//
+//  KQSHyperLogLogTestCase.m
+//  QuicksilverTests-iOS
+//
+//  Created by William Towe on 10/19/26.
+//  Copyright © 2021 Kosoku Interactive, LLC. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#import <XCTest/XCTest.h>
+
+#import <Quicksilver/Quicksilver.h>
+
+@interface KQSHyperLogLogTestCase : XCTestCase
+
+@end
+
+@implementation KQSHyperLogLogTestCase
+
+- (void)testEmpty {
+    XCTAssertEqual([[KQSHyperLogLog alloc] init].count, 0);
+    XCTAssertEqual([@[] KQS_approximateDistinctCount], 0);
+}
+- (void)testSmall {
+    KQSHyperLogLog *sketch = [[KQSHyperLogLog alloc] init];
+    
+    for (NSInteger i=0; i<100; i++) {
+        [sketch addObject:@(i % 10)];
+    }
+    
+    XCTAssertEqual(sketch.count, 10);
+}
+- (void)testLarge {
+    NSMutableArray *begin = [[NSMutableArray alloc] init];
+    
+    for (NSInteger i=0; i<200000; i++) {
+        [begin addObject:@(i % 50000)];
+    }
+    
+    NSUInteger count = [begin KQS_approximateDistinctCount];
+    
+    XCTAssertEqualWithAccuracy((double)count, 50000.0, 50000.0 * 0.03);
+    XCTAssertEqual([begin KQS_hyperLogLogWithPrecision:KQSHyperLogLogDefaultPrecision concurrent:YES].count, count);
+}
+- (void)testUnion {
+    KQSHyperLogLog *first = [[KQSHyperLogLog alloc] initWithPrecision:12];
+    KQSHyperLogLog *second = [[KQSHyperLogLog alloc] initWithPrecision:12];
+    
+    for (NSInteger i=0; i<1000; i++) {
+        [first addObject:@(i)];
+        [second addObject:@(i + 500)];
+    }
+    
+    KQSHyperLogLog *copy = [first copy];
+    
+    [first unionHyperLogLog:second];
+    
+    XCTAssertEqualWithAccuracy((double)first.count, 1500.0, 1500.0 * 0.1);
+    XCTAssertEqualWithAccuracy((double)copy.count, 1000.0, 1000.0 * 0.1);
+    
+    XCTAssertThrows([first unionHyperLogLog:[[KQSHyperLogLog alloc] initWithPrecision:10]]);
+    XCTAssertThrows([[KQSHyperLogLog alloc] initWithPrecision:3]);
+}
+- (void)testCollections {
+    XCTAssertEqual([[NSSet setWithArray:@[@1,@2,@3]] KQS_approximateDistinctCount], 3);
+    XCTAssertEqual([[NSOrderedSet orderedSetWithArray:@[@1,@2,@3,@4]] KQS_approximateDistinctCount], 4);
+    XCTAssertEqual([@{@"a": @1, @"b": @1, @"c": @2} KQS_approximateDistinctCount], 2);
+    XCTAssertEqual([KQSHyperLogLog hyperLogLogWithObjects:@[@1,@2,@2].objectEnumerator precision:KQSHyperLogLogDefaultPrecision].count, 2);
+}
+
+@end
@@ -0,0 +1,153 @@
+//
+//  KQSKeyPathTestCase.m
+//  QuicksilverTests-iOS
+//
+//  Created by William Towe on 10/19/26.
+//  Copyright © 2021 Kosoku Interactive, LLC. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#import <XCTest/XCTest.h>
+
+#import <Quicksilver/Quicksilver.h>
+
+@interface KQSKeyPathTestPerson : NSObject
+@property (copy,nonatomic) NSString *name;
+@property (assign,nonatomic) NSInteger age;
+@property (assign,nonatomic) double score;
+@property (assign,nonatomic,getter=isActive) BOOL active;
+@property (strong,nonatomic) KQSKeyPathTestPerson *parent;
+
++ (instancetype)personWithName:(NSString *)name age:(NSInteger)age score:(double)score;
+@end
+
+@implementation KQSKeyPathTestPerson
++ (instancetype)personWithName:(NSString *)name age:(NSInteger)age score:(double)score {
+    KQSKeyPathTestPerson *retval = [[self alloc] init];
+    
+    retval.name = name;
+    retval.age = age;
+    retval.score = score;
+    retval.active = age % 2 == 0;
+    
+    return retval;
+}
+@end
+
+@interface KQSKeyPathTestCase : XCTestCase
+@property (copy,nonatomic) NSArray<KQSKeyPathTestPerson *> *people;
+@end
+
+@implementation KQSKeyPathTestCase
+
+- (void)setUp {
+    [super setUp];
+    
+    KQSKeyPathTestPerson *parent = [KQSKeyPathTestPerson personWithName:@"parent" age:60 score:1.0];
+    NSMutableArray *people = [[NSMutableArray alloc] init];
+    
+    [people addObject:[KQSKeyPathTestPerson personWithName:@"a" age:30 score:2.5]];
+    [people addObject:[KQSKeyPathTestPerson personWithName:@"b" age:20 score:1.5]];
+    [people addObject:[KQSKeyPathTestPerson personWithName:@"c" age:30 score:3.0]];
+    [people addObject:[KQSKeyPathTestPerson personWithName:@"d" age:41 score:0.5]];
+    
+    [people.firstObject setParent:parent];
+    [people.lastObject setParent:parent];
+    
+    self.people = people;
+}
+
+- (void)testArrayPluck {
+    XCTAssertEqualObjects([self.people KQS_pluck:@"name"], (@[@"a",@"b",@"c",@"d"]));
+    XCTAssertEqualObjects([self.people KQS_pluck:@"age"], (@[@30,@20,@30,@41]));
+    XCTAssertEqualObjects([self.people KQS_pluck:@"parent.name"], (@[@"parent",[NSNull null],[NSNull null],@"parent"]));
+    XCTAssertEqualObjects([self.people KQS_pluck:@"active"], [self.people valueForKey:@"active"]);
+    XCTAssertEqualObjects([@[@{@"a": @1},@{@"a": @2}] KQS_pluck:@"a"], (@[@1,@2]));
+    XCTAssertEqualObjects([@[@[@1,@2],@[@3]] KQS_pluck:@"@count"], (@[@2,@1]));
+}
+- (void)testArrayFilter {
+    XCTAssertEqualObjects([[self.people KQS_filterWhereKeyPath:@"age" equals:@30] KQS_pluck:@"name"], (@[@"a",@"c"]));
+    XCTAssertEqualObjects([[self.people KQS_filterWhereKeyPath:@"parent" equals:nil] KQS_pluck:@"name"], (@[@"b",@"c"]));
+    XCTAssertEqualObjects([[self.people KQS_filterWhereKeyPath:@"parent.age" equals:[NSNull null]] KQS_pluck:@"name"], (@[@"b",@"c"]));
+}
+- (void)testArraySort {
+    XCTAssertEqualObjects([[self.people KQS_sortByKeyPath:@"score"] KQS_pluck:@"name"], (@[@"d",@"b",@"a",@"c"]));
+    XCTAssertEqualObjects([[self.people KQS_sortByKeyPath:@"age" ascending:NO] KQS_pluck:@"name"], (@[@"d",@"a",@"c",@"b"]));
+    XCTAssertEqualObjects([[self.people KQS_sortByKeyPath:@"parent.name"] KQS_pluck:@"name"], (@[@"b",@"c",@"a",@"d"]));
+}
+- (void)testArrayAggregates {
+    XCTAssertEqualObjects([self.people KQS_sumOfKeyPath:@"age"], @121);
+    XCTAssertEqualObjects([self.people KQS_sumOfKeyPath:@"score"], @7.5);
+    XCTAssertEqualObjects([self.people KQS_sumOfKeyPath:@"parent.age"], @120);
+    XCTAssertEqualObjects([@[] KQS_sumOfKeyPath:@"age"], @0);
+    XCTAssertEqualObjects([[self.people KQS_maximumByKeyPath:@"score"] name], @"c");
+    XCTAssertEqualObjects([[self.people KQS_minimumByKeyPath:@"age"] name], @"b");
+    XCTAssertEqualObjects([[self.people KQS_maximumByKeyPath:@"name"] name], @"d");
+    XCTAssertNil([@[] KQS_maximumByKeyPath:@"age"]);
+}
+- (void)testSumOverflow {
+    NSArray *begin = @[@{@"age": @(LLONG_MAX)},@{@"age": @1}];
+    
+    XCTAssertEqualObjects([begin KQS_sumOfKeyPath:@"age"], [NSDecimalNumber decimalNumberWithString:@"9223372036854775808"]);
+    
+    begin = @[@{@"age": @(ULLONG_MAX)},@{@"age": @(ULLONG_MAX)}];
+    
+    XCTAssertEqualObjects([begin KQS_sumOfKeyPath:@"age"], [NSDecimalNumber decimalNumberWithString:@"36893488147419103230"]);
+    XCTAssertEqualObjects([[@[@{@"age": @(ULLONG_MAX)},@{@"age": @(-1)}] KQS_sumOfKeyPath:@"age"] description], @"18446744073709551614");
+    XCTAssertEqualObjects([[@[@{@"age": @(ULLONG_MAX)},@{@"age": @(LLONG_MAX)}] KQS_maximumByKeyPath:@"age"] objectForKey:@"age"], @(ULLONG_MAX));
+}
+- (void)testArrayGroup {
+    NSDictionary<id, NSArray<KQSKeyPathTestPerson *> *> *groups = [self.people KQS_groupByKeyPath:@"age"];
+    
+    XCTAssertEqual(groups.count, 3);
+    XCTAssertEqualObjects([groups[@30] KQS_pluck:@"name"], (@[@"a",@"c"]));
+    XCTAssertEqualObjects([[self.people KQS_groupByKeyPath:@"parent"][[NSNull null]] KQS_pluck:@"name"], (@[@"b",@"c"]));
+}
+- (void)testMixedClasses {
+    NSArray *begin = @[[KQSKeyPathTestPerson personWithName:@"a" age:1 score:0],@{@"age": @2},[KQSKeyPathTestPerson personWithName:@"b" age:3 score:0]];
+    
+    XCTAssertEqualObjects([begin KQS_pluck:@"age"], (@[@1,@2,@3]));
+    XCTAssertEqualObjects([begin KQS_sumOfKeyPath:@"age"], @6);
+}
+- (void)testSet {
+    NSSet *begin = [NSSet setWithArray:self.people];
+    
+    XCTAssertEqualObjects([begin KQS_pluck:@"age"], ([NSSet setWithArray:@[@20,@30,@41]]));
+    XCTAssertEqual([begin KQS_filterWhereKeyPath:@"age" equals:@30].count, 2);
+    XCTAssertEqualObjects([[begin KQS_sortByKeyPath:@"score"] valueForKey:@"name"], (@[@"d",@"b",@"a",@"c"]));
+    XCTAssertEqualObjects([begin KQS_sumOfKeyPath:@"age"], @121);
+    XCTAssertEqualObjects([[begin KQS_maximumByKeyPath:@"age"] name], @"d");
+    XCTAssertEqual([[begin KQS_groupByKeyPath:@"age"][@30] count], 2);
+}
+- (void)testOrderedSet {
+    NSOrderedSet *begin = [NSOrderedSet orderedSetWithArray:self.people];
+    
+    XCTAssertEqualObjects([begin KQS_pluck:@"name"], ([NSOrderedSet orderedSetWithArray:@[@"a",@"b",@"c",@"d"]]));
+    XCTAssertEqualObjects([[begin KQS_filterWhereKeyPath:@"active" equals:@YES] KQS_pluck:@"name"], ([NSOrderedSet orderedSetWithArray:@[@"a",@"b",@"c"]]));
+    XCTAssertEqualObjects([[begin KQS_sortByKeyPath:@"age"] KQS_pluck:@"name"], ([NSOrderedSet orderedSetWithArray:@[@"b",@"a",@"c",@"d"]]));
+    XCTAssertEqualObjects([begin KQS_sumOfKeyPath:@"score"], @7.5);
+    XCTAssertEqualObjects([[begin KQS_minimumByKeyPath:@"score"] name], @"d");
+    XCTAssertEqualObjects([[begin KQS_groupByKeyPath:@"age"][@30] KQS_pluck:@"name"], ([NSOrderedSet orderedSetWithArray:@[@"a",@"c"]]));
+}
+- (void)testDictionary {
+    NSDictionary *begin = @{@"w": self.people[0], @"x": self.people[1], @"y": self.people[2], @"z": self.people[3]};
+    
+    XCTAssertEqualObjects([begin KQS_pluck:@"age"], (@{@"w": @30, @"x": @20, @"y": @30, @"z": @41}));
+    XCTAssertEqual([begin KQS_filterWhereKeyPath:@"age" equals:@30].allKeys.count, 2);
+    XCTAssertEqualObjects([begin KQS_sortByKeyPath:@"score"], (@[@"z",@"x",@"w",@"y"]));
+    XCTAssertEqualObjects([begin KQS_sumOfKeyPath:@"age"], @121);
+    XCTAssertEqualObjects([[begin KQS_maximumByKeyPath:@"age"] name], @"d");
+    XCTAssertEqualObjects([begin KQS_groupByKeyPath:@"age"][@30], (@{@"w": self.people[0], @"y": self.people[2]}));
+}
+
+@end
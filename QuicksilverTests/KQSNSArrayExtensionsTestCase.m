@@ -20,6 +20,9 @@
 #import <XCTest/XCTest.h>
 
 #import <Quicksilver/NSArray+KQSExtensions.h>
+#import <Quicksilver/KQSAsyncTask.h>
+#import <Quicksilver/NSMutableArray+KQSExtensions.h>
+#import <Quicksilver/KQSRandom.h>
 
 @interface KQSNSArrayExtensionsTestCase : XCTestCase
 
@@ -219,6 +222,40 @@
     
     XCTAssertEqualObjects([begin KQS_sum], end);
 }
+- (void)testReduceFloat {
+    NSArray *begin = @[@0.2];
+    CGFloat end = (CGFloat)0.1 + (CGFloat)0.2;
+    
+    XCTAssertEqual([begin KQS_reduceFloatWithStart:0.1 block:^CGFloat(CGFloat sum, NSNumber *object, NSInteger index) {
+        return sum + object.doubleValue;
+    }], end);
+}
+- (void)testSumPrecise {
+    NSMutableArray *begin = [[NSMutableArray alloc] init];
+    
+    for (NSInteger i=0; i<1000000; i++) {
+        [begin addObject:@0.1];
+    }
+    
+    XCTAssertEqual([[begin KQS_sumPrecise] doubleValue], 100000.0);
+    XCTAssertNotEqual([[begin KQS_sum] doubleValue], 100000.0);
+    XCTAssertEqual([[@[@1e100,@1.0,@-1e100] KQS_sumPrecise] doubleValue], 1.0);
+    XCTAssertEqualObjects([@[] KQS_sumPrecise], @0.0);
+}
+- (void)testSumPairwise {
+    NSMutableArray *begin = [[NSMutableArray alloc] init];
+    
+    for (NSInteger i=0; i<1000003; i++) {
+        [begin addObject:@(0.1 + (i % 1000) * 1e-7)];
+    }
+    
+    NSNumber *serial = [begin KQS_sumPairwise];
+    
+    XCTAssertEqualWithAccuracy(serial.doubleValue, [[begin KQS_sumPrecise] doubleValue], 1e-8);
+    XCTAssertEqual([[begin KQS_sumPairwiseConcurrently] doubleValue], serial.doubleValue);
+    XCTAssertEqualObjects([@[@1,@2,@3] KQS_sumPairwise], @6.0);
+    XCTAssertEqualObjects([@[] KQS_sumPairwiseConcurrently], @0.0);
+}
 - (void)testProduct {
     NSArray *begin = @[@2,@3,@4];
     NSNumber *end = @24;
@@ -247,5 +284,90 @@
     
     XCTAssertEqualObjects([begin KQS_minimum], end);
 }
+- (void)testAsyncMap {
+    XCTestExpectation *expectation = [self expectationWithDescription:@"map"];
+    NSArray *begin = @[@1,@2,@3];
+    NSArray *end = @[@"1",[NSNull null],@"3"];
+    
+    [begin KQS_asyncMap:^(NSNumber * _Nonnull object, NSInteger index, void (^ _Nonnull completion)(id _Nullable)) {
+        dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+            completion(index == 1 ? nil : object.stringValue);
+        });
+    } maxConcurrency:2 completion:^(NSArray * _Nullable array, NSError * _Nullable error) {
+        XCTAssertEqualObjects(array, end);
+        [expectation fulfill];
+    }];
+    
+    [self waitForExpectationsWithTimeout:5.0 handler:nil];
+}
+- (void)testAsyncFilter {
+    XCTestExpectation *expectation = [self expectationWithDescription:@"filter"];
+    NSArray *begin = @[@1,@2,@3,@4];
+    NSArray *end = @[@2,@4];
+    
+    [begin KQS_asyncFilter:^(NSNumber * _Nonnull object, NSInteger index, void (^ _Nonnull completion)(BOOL)) {
+        completion(object.integerValue % 2 == 0);
+    } maxConcurrency:0 completion:^(NSArray * _Nullable array, NSError * _Nullable error) {
+        XCTAssertEqualObjects(array, end);
+        [expectation fulfill];
+    }];
+    
+    [self waitForExpectationsWithTimeout:5.0 handler:nil];
+}
+- (void)testSample {
+    NSMutableArray *begin = [[NSMutableArray alloc] init];
+    
+    for (NSInteger i=0; i<1000; i++) {
+        [begin addObject:@(i)];
+    }
+    
+    NSArray *end = [begin KQS_sample:10];
+    
+    XCTAssertEqual(end.count, 10);
+    XCTAssertEqual([NSSet setWithArray:end].count, 10);
+    XCTAssertTrue([[NSSet setWithArray:end] isSubsetOfSet:[NSSet setWithArray:begin]]);
+    XCTAssertEqualObjects([begin KQS_sample:10 random:[[KQSRandom alloc] initWithSeed:1]], [begin KQS_sample:10 random:[[KQSRandom alloc] initWithSeed:1]]);
+    XCTAssertEqualObjects([NSSet setWithArray:[begin KQS_sample:2000]], [NSSet setWithArray:begin]);
+    XCTAssertEqualObjects([begin KQS_sample:0], @[]);
+    XCTAssertEqualObjects([begin KQS_sample:-1], @[]);
+    XCTAssertEqualObjects([@[] KQS_sample:3], @[]);
+}
+- (void)testSampleWeighted {
+    NSArray *begin = @[@0,@1,@2,@3];
+    NSArray *end = [begin KQS_sampleWeighted:4 block:^double(NSNumber *object, NSInteger index) {
+        return object.doubleValue;
+    }];
+    
+    XCTAssertEqualObjects([NSSet setWithArray:end], ([NSSet setWithArray:@[@1,@2,@3]]));
+    XCTAssertEqualObjects([begin KQS_sampleWeighted:0 block:^double(id object, NSInteger index) {
+        return 1.0;
+    }], @[]);
+}
+- (void)testShuffle {
+    NSMutableArray *begin = [[NSMutableArray alloc] init];
+    
+    for (NSInteger i=0; i<100; i++) {
+        [begin addObject:@(i)];
+    }
+    
+    NSMutableArray *first = [begin mutableCopy], *second = [begin mutableCopy];
+    
+    [first KQS_shuffleWithRandom:[[KQSRandom alloc] initWithSeed:1]];
+    [second KQS_shuffleWithRandom:[[KQSRandom alloc] initWithSeed:1]];
+    
+    XCTAssertEqualObjects(first, second);
+    XCTAssertNotEqualObjects(first, begin);
+    XCTAssertEqualObjects([NSSet setWithArray:first], [NSSet setWithArray:begin]);
+    
+    [second KQS_shuffle];
+    
+    XCTAssertEqualObjects([NSSet setWithArray:second], [NSSet setWithArray:begin]);
+    
+    NSMutableArray *empty = [[NSMutableArray alloc] init];
+    
+    [empty KQS_shuffle];
+    
+    XCTAssertEqualObjects(empty, @[]);
+}
 
 @end
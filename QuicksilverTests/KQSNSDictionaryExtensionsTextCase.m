@@ -20,6 +20,8 @@
 #import <XCTest/XCTest.h>
 
 #import <Quicksilver/NSDictionary+KQSExtensions.h>
+#import <Quicksilver/KQSAsyncTask.h>
+#import <Quicksilver/KQSRandom.h>
 
 @interface KQSNSDictionaryExtensionsTextCase : XCTestCase
 
@@ -100,6 +102,51 @@
         return value.uppercaseString;
     }], end);
 }
+- (void)testEachLeaf {
+    NSDictionary *begin = @{@"a": @{@"b": @1, @"c": @{@"d": @2}}, @"e": @3, @"f": @{}};
+    NSMutableDictionary *temp = [[NSMutableDictionary alloc] init];
+    NSDictionary *end = @{@[@"a",@"b"]: @1, @[@"a",@"c",@"d"]: @2, @[@"e"]: @3, @[@"f"]: @{}};
+    
+    [begin KQS_eachLeaf:^(NSArray * _Nonnull keyPath, id  _Nonnull value, BOOL * _Nonnull stop) {
+        [temp setObject:value forKey:[keyPath copy]];
+    }];
+    
+    XCTAssertEqualObjects(temp, end);
+    
+    __block NSInteger count = 0;
+    
+    [begin KQS_eachLeaf:^(NSArray * _Nonnull keyPath, id  _Nonnull value, BOOL * _Nonnull stop) {
+        count++;
+        *stop = YES;
+    }];
+    
+    XCTAssertEqual(count, 1);
+}
+- (void)testFlattenDeep {
+    NSDictionary *begin = @{@"a": @{@"b": @1, @"c": @{@"d": @2}}, @"e": @3, @4: @{@5: @6}};
+    NSDictionary *end = @{@"a.b": @1, @"a.c.d": @2, @"e": @3, @"4.5": @6};
+    
+    XCTAssertEqualObjects([begin KQS_flattenDeepWithSeparator:@"."], end);
+    
+    begin = @{@"a": @{@"b": @1}, @"a.b": @2};
+    
+    XCTAssertEqual([begin KQS_flattenDeepWithSeparator:@"." conflictPolicy:KQSDictionaryConflictPolicyFirstWins].count, 1);
+    XCTAssertThrows([begin KQS_flattenDeepWithSeparator:@"." conflictPolicy:KQSDictionaryConflictPolicyThrow]);
+}
+- (void)testUnflatten {
+    NSDictionary *begin = @{@"a.b": @1, @"a.c.d": @2, @"e": @3};
+    NSDictionary *end = @{@"a": @{@"b": @1, @"c": @{@"d": @2}}, @"e": @3};
+    
+    XCTAssertEqualObjects([begin KQS_unflatten], end);
+    XCTAssertFalse([[begin KQS_unflatten][@"a"] isKindOfClass:NSMutableDictionary.class]);
+    XCTAssertFalse([[begin KQS_unflatten][@"a"][@"c"] isKindOfClass:NSMutableDictionary.class]);
+    XCTAssertEqualObjects([[end KQS_flattenDeepWithSeparator:@"/"] KQS_unflattenWithSeparator:@"/" conflictPolicy:KQSDictionaryConflictPolicyThrow], end);
+    
+    begin = @{@"a": @1, @"a.b": @2};
+    
+    XCTAssertThrows([begin KQS_unflattenWithSeparator:@"." conflictPolicy:KQSDictionaryConflictPolicyThrow]);
+    XCTAssertEqual([begin KQS_unflattenWithSeparator:@"." conflictPolicy:KQSDictionaryConflictPolicyFirstWins].count, 1);
+}
 - (void)testAny {
     NSDictionary *begin = @{@1: @"one", @2: @"two", @3: @"three"};
     
@@ -171,6 +218,16 @@
     
     XCTAssertEqualObjects([begin KQS_sumOfValues], end);
 }
+- (void)testSumPrecise {
+    NSDictionary *begin = @{@1e100: @1.0, @1.0: @1e100, @-1e100: @-1e100};
+    
+    XCTAssertEqualObjects([begin KQS_sumOfKeysPrecise], @1.0);
+    XCTAssertEqualObjects([begin KQS_sumOfValuesPrecise], @1.0);
+    XCTAssertEqualObjects([@{@1: @"one", @2: @"two", @3: @"three"} KQS_sumOfKeysPairwise], @6.0);
+    XCTAssertEqualObjects([@{@1: @"one", @2: @"two", @3: @"three"} KQS_sumOfKeysPairwiseConcurrently], @6.0);
+    XCTAssertEqualObjects([@{@"one": @1, @"two": @2, @"three": @3} KQS_sumOfValuesPairwise], @6.0);
+    XCTAssertEqualObjects([@{@"one": @1, @"two": @2, @"three": @3} KQS_sumOfValuesPairwiseConcurrently], @6.0);
+}
 - (void)testProductOfKeys {
     NSDictionary *begin = @{@2: @"one", @3: @"two", @4: @"three"};
     NSNumber *end = @24;
@@ -227,5 +284,40 @@
     
     XCTAssertEqualObjects([begin KQS_minimumValue], end);
 }
+- (void)testAsyncFilter {
+    XCTestExpectation *expectation = [self expectationWithDescription:@"filter"];
+    NSDictionary *begin = @{@1: @"one", @2: @"two", @3: @"three", @4: @"four"};
+    NSDictionary *end = @{@2: @"two", @4: @"four"};
+    
+    [begin KQS_asyncFilter:^(NSNumber * _Nonnull key, NSString * _Nonnull value, void (^ _Nonnull completion)(BOOL)) {
+        completion(key.integerValue % 2 == 0);
+    } maxConcurrency:2 completion:^(NSDictionary * _Nullable dictionary, NSError * _Nullable error) {
+        XCTAssertEqualObjects(dictionary, end);
+        [expectation fulfill];
+    }];
+    
+    [self waitForExpectationsWithTimeout:5.0 handler:nil];
+}
+- (void)testSample {
+    NSMutableDictionary *begin = [[NSMutableDictionary alloc] init];
+    
+    for (NSInteger i=0; i<1000; i++) {
+        begin[@(i)] = @(i * 2).stringValue;
+    }
+    
+    NSDictionary *end = [begin KQS_sample:10];
+    
+    XCTAssertEqual(end.count, 10);
+    
+    [end enumerateKeysAndObjectsUsingBlock:^(NSNumber * _Nonnull key, NSString * _Nonnull obj, BOOL * _Nonnull stop) {
+        XCTAssertEqualObjects(begin[key], obj);
+    }];
+    
+    XCTAssertEqualObjects([begin KQS_sample:10 random:[[KQSRandom alloc] initWithSeed:1]], [begin KQS_sample:10 random:[[KQSRandom alloc] initWithSeed:1]]);
+    XCTAssertEqualObjects([begin KQS_sample:2000], begin);
+    XCTAssertEqualObjects([begin KQS_sampleWeighted:5 block:^double(NSNumber *key, NSString *value) {
+        return [value isEqualToString:@"6"] ? 1.0 : 0.0;
+    }], @{@3: @"6"});
+}
 
 @end
@@ -20,6 +20,8 @@
 #import <XCTest/XCTest.h>
 
 #import <Quicksilver/NSOrderedSet+KQSExtensions.h>
+#import <Quicksilver/KQSAsyncTask.h>
+#import <Quicksilver/KQSRandom.h>
 
 @interface KQSNSOrderedSetExtensionsTestCase : XCTestCase
 
@@ -218,6 +220,13 @@
     
     XCTAssertEqualObjects([begin KQS_sum], end);
 }
+- (void)testSumPrecise {
+    NSOrderedSet *begin = [NSOrderedSet orderedSetWithArray:@[@1e100,@1.0,@-1e100]];
+    
+    XCTAssertEqualObjects([begin KQS_sumPrecise], @1.0);
+    XCTAssertEqualObjects([[NSOrderedSet orderedSetWithArray:@[@1,@2,@3]] KQS_sumPairwise], @6.0);
+    XCTAssertEqualObjects([[NSOrderedSet orderedSetWithArray:@[@1,@2,@3]] KQS_sumPairwiseConcurrently], @6.0);
+}
 - (void)testProduct {
     NSOrderedSet *begin = [NSOrderedSet orderedSetWithArray:@[@2,@3,@4]];
     NSNumber *end = @24;
@@ -251,5 +260,35 @@
     
     XCTAssertEqualObjects([begin KQS_minimum], end);
 }
+- (void)testAsyncMap {
+    XCTestExpectation *expectation = [self expectationWithDescription:@"map"];
+    NSOrderedSet *begin = [NSOrderedSet orderedSetWithArray:@[@1,@2,@3]];
+    NSOrderedSet *end = [NSOrderedSet orderedSetWithArray:@[@"1",@"2",@"3"]];
+    
+    [begin KQS_asyncMap:^(NSNumber * _Nonnull object, NSInteger index, void (^ _Nonnull completion)(id _Nullable)) {
+        completion(object.stringValue);
+    } maxConcurrency:2 completion:^(NSOrderedSet * _Nullable orderedSet, NSError * _Nullable error) {
+        XCTAssertEqualObjects(orderedSet, end);
+        [expectation fulfill];
+    }];
+    
+    [self waitForExpectationsWithTimeout:5.0 handler:nil];
+}
+- (void)testSample {
+    NSMutableOrderedSet *begin = [[NSMutableOrderedSet alloc] init];
+    
+    for (NSInteger i=0; i<1000; i++) {
+        [begin addObject:@(i)];
+    }
+    
+    NSOrderedSet *end = [begin KQS_sample:10];
+    
+    XCTAssertEqual(end.count, 10);
+    XCTAssertTrue([end isSubsetOfOrderedSet:begin]);
+    XCTAssertEqualObjects([begin KQS_sample:10 random:[[KQSRandom alloc] initWithSeed:1]], [begin KQS_sample:10 random:[[KQSRandom alloc] initWithSeed:1]]);
+    XCTAssertEqualObjects([begin KQS_sampleWeighted:5 block:^double(NSNumber *object, NSInteger index) {
+        return index == 7 ? 1.0 : 0.0;
+    }], [NSOrderedSet orderedSetWithObject:@7]);
+}
 
 @end
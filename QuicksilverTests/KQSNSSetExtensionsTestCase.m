@@ -20,6 +20,7 @@
 #import <XCTest/XCTest.h>
 
 #import <Quicksilver/NSSet+KQSExtensions.h>
+#import <Quicksilver/KQSRandom.h>
 
 @interface KQSNSSetExtensionsTestCase : XCTestCase
 
@@ -148,6 +149,13 @@
     
     XCTAssertEqualObjects([begin KQS_sum], end);
 }
+- (void)testSumPrecise {
+    NSSet *begin = [NSSet setWithArray:@[@1e100,@1.0,@-1e100]];
+    
+    XCTAssertEqualObjects([begin KQS_sumPrecise], @1.0);
+    XCTAssertEqualObjects([[NSSet setWithArray:@[@1,@2,@3]] KQS_sumPairwise], @6.0);
+    XCTAssertEqualObjects([[NSSet setWithArray:@[@1,@2,@3]] KQS_sumPairwiseConcurrently], @6.0);
+}
 - (void)testProduct {
     NSSet *begin = [NSSet setWithArray:@[@2,@3,@4]];
     NSNumber *end = @24;
@@ -176,5 +184,22 @@
     
     XCTAssertEqualObjects([begin KQS_minimum], end);
 }
+- (void)testSample {
+    NSMutableSet *begin = [[NSMutableSet alloc] init];
+    
+    for (NSInteger i=0; i<1000; i++) {
+        [begin addObject:@(i)];
+    }
+    
+    NSSet *end = [begin KQS_sample:10];
+    
+    XCTAssertEqual(end.count, 10);
+    XCTAssertTrue([end isSubsetOfSet:begin]);
+    XCTAssertEqualObjects([begin KQS_sample:10 random:[[KQSRandom alloc] initWithSeed:1]], [begin KQS_sample:10 random:[[KQSRandom alloc] initWithSeed:1]]);
+    XCTAssertEqualObjects([begin KQS_sample:2000], begin);
+    XCTAssertEqualObjects([begin KQS_sampleWeighted:5 block:^double(NSNumber *object) {
+        return object.integerValue < 2 ? 1.0 : 0.0;
+    }], ([NSSet setWithObjects:@0,@1, nil]));
+}
 
 @end
@@ -0,0 +1,277 @@
+//
+//  KQSPersistentVectorTestCase.m
+//  QuicksilverTests-iOS
+//
+//  Created by William Towe on 10/19/26.
+//  Copyright © 2021 Kosoku Interactive, LLC. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#import <XCTest/XCTest.h>
+
+#import <Quicksilver/KQSPersistentVector.h>
+#import <Quicksilver/NSArray+KQSExtensions.h>
+
+@interface KQSPersistentVectorTestCase : XCTestCase
+
+@end
+
+@implementation KQSPersistentVectorTestCase
+
+- (NSArray *)_rangeArrayWithCount:(NSUInteger)count {
+    NSMutableArray *retval = [[NSMutableArray alloc] initWithCapacity:count];
+
+    for (NSUInteger i=0; i<count; i++) {
+        [retval addObject:@(i)];
+    }
+
+    return retval;
+}
+
+- (void)testArrayRoundTrip {
+    for (NSNumber *count in @[@0,@1,@32,@33,@1024,@1025,@40000]) {
+        NSArray *begin = [self _rangeArrayWithCount:count.unsignedIntegerValue];
+        KQSPersistentVector *vector = [KQSPersistentVector vectorWithArray:begin];
+
+        XCTAssertEqual(vector.count, begin.count);
+        XCTAssertEqualObjects(vector.array, begin);
+        XCTAssertEqualObjects(vector.firstObject, begin.firstObject);
+        XCTAssertEqualObjects(vector.lastObject, begin.lastObject);
+    }
+}
+- (void)testFastEnumeration {
+    NSArray *begin = [self _rangeArrayWithCount:5000];
+    NSMutableArray *end = [[NSMutableArray alloc] init];
+
+    for (NSNumber *object in [KQSPersistentVector vectorWithArray:begin]) {
+        [end addObject:object];
+    }
+
+    XCTAssertEqualObjects(end, begin);
+}
+- (void)testAddObject {
+    NSMutableArray *end = [[NSMutableArray alloc] init];
+    KQSPersistentVector *vector = [KQSPersistentVector vector];
+
+    for (NSUInteger i=0; i<2000; i++) {
+        KQSPersistentVector *next = [vector vectorByAddingObject:@(i)];
+
+        XCTAssertEqual(vector.count, i);
+
+        vector = next;
+        [end addObject:@(i)];
+    }
+
+    XCTAssertEqualObjects(vector.array, end);
+}
+- (void)testReplaceObject {
+    NSArray *begin = [self _rangeArrayWithCount:3000];
+    KQSPersistentVector *vector = [KQSPersistentVector vectorWithArray:begin];
+    KQSPersistentVector *replaced = [vector vectorByReplacingObjectAtIndex:1234 withObject:@"a"];
+
+    XCTAssertEqualObjects(replaced[1234], @"a");
+    XCTAssertEqualObjects(vector[1234], @1234);
+    XCTAssertEqualObjects(vector.array, begin);
+    XCTAssertThrows([vector vectorByReplacingObjectAtIndex:begin.count withObject:@"a"]);
+}
+- (void)testSubvector {
+    NSArray *begin = [self _rangeArrayWithCount:2500];
+    KQSPersistentVector *vector = [KQSPersistentVector vectorWithArray:begin];
+
+    for (NSValue *value in @[[NSValue valueWithRange:NSMakeRange(0, 0)],
+                             [NSValue valueWithRange:NSMakeRange(0, 1)],
+                             [NSValue valueWithRange:NSMakeRange(31, 2)],
+                             [NSValue valueWithRange:NSMakeRange(1000, 1500)],
+                             [NSValue valueWithRange:NSMakeRange(17, 2000)],
+                             [NSValue valueWithRange:NSMakeRange(0, 2500)]]) {
+        XCTAssertEqualObjects([vector subvectorWithRange:value.rangeValue].array, [begin subarrayWithRange:value.rangeValue]);
+    }
+
+    XCTAssertThrows([vector subvectorWithRange:NSMakeRange(2000, 501)]);
+}
+- (void)testConcatenate {
+    NSArray *counts = @[@0,@1,@5,@31,@32,@33,@700,@1025,@3000];
+
+    for (NSNumber *leftCount in counts) {
+        for (NSNumber *rightCount in counts) {
+            NSArray *left = [self _rangeArrayWithCount:leftCount.unsignedIntegerValue];
+            NSArray *right = [self _rangeArrayWithCount:rightCount.unsignedIntegerValue];
+            KQSPersistentVector *leftVector = [[KQSPersistentVector vectorWithArray:left] subvectorWithRange:NSMakeRange(0, left.count)];
+            KQSPersistentVector *rightVector = [KQSPersistentVector vectorWithArray:right];
+
+            XCTAssertEqualObjects([leftVector vectorByAddingObjectsFromVector:rightVector].array, [left arrayByAddingObjectsFromArray:right]);
+        }
+    }
+}
+- (void)testRepeatedConcatenate {
+    NSArray *chunk = [self _rangeArrayWithCount:17];
+    KQSPersistentVector *chunkVector = [KQSPersistentVector vectorWithArray:chunk];
+    NSMutableArray *array = [[NSMutableArray alloc] init];
+    KQSPersistentVector *vector = [KQSPersistentVector vector];
+
+    // half full leaves never fit together, so without rebalancing every seam would leave a sparse node behind
+    for (NSUInteger i=0; i<2000; i++) {
+        if (i % 2 == 0) {
+            [array addObjectsFromArray:chunk];
+            vector = [vector vectorByAddingObjectsFromVector:chunkVector];
+        }
+        else {
+            [array insertObjects:chunk atIndexes:[NSIndexSet indexSetWithIndexesInRange:NSMakeRange(0, chunk.count)]];
+            vector = [chunkVector vectorByAddingObjectsFromVector:vector];
+        }
+    }
+
+    XCTAssertEqualObjects(vector.array, array);
+
+    for (NSUInteger i=0; i<array.count; i+=97) {
+        XCTAssertEqualObjects(vector[i], array[i]);
+    }
+}
+- (void)testRandomOperations {
+    NSMutableArray<NSArray *> *arrays = [NSMutableArray arrayWithObject:@[]];
+    NSMutableArray<KQSPersistentVector *> *vectors = [NSMutableArray arrayWithObject:[KQSPersistentVector vector]];
+
+    srand48(26);
+
+    for (NSUInteger i=0; i<500; i++) {
+        NSUInteger index = lrand48() % arrays.count;
+        NSArray *array = arrays[index];
+        KQSPersistentVector *vector = vectors[index];
+
+        switch (lrand48() % 4) {
+            case 0:
+                array = [array arrayByAddingObject:@(i)];
+                vector = [vector vectorByAddingObject:@(i)];
+                break;
+            case 1: {
+                NSUInteger other = lrand48() % arrays.count;
+
+                array = [array arrayByAddingObjectsFromArray:arrays[other]];
+                vector = [vector vectorByAddingObjectsFromVector:vectors[other]];
+            }
+                break;
+            case 2: {
+                NSUInteger location = lrand48() % (array.count + 1);
+                NSRange range = NSMakeRange(location, lrand48() % (array.count - location + 1));
+
+                array = [array subarrayWithRange:range];
+                vector = [vector subvectorWithRange:range];
+            }
+                break;
+            default:
+                if (array.count > 0) {
+                    NSUInteger replace = lrand48() % array.count;
+                    NSMutableArray *temp = [array mutableCopy];
+
+                    temp[replace] = @(i);
+                    array = temp;
+                    vector = [vector vectorByReplacingObjectAtIndex:replace withObject:@(i)];
+                }
+                break;
+        }
+
+        XCTAssertEqualObjects(vector.array, array);
+
+        if (array.count < 10000) {
+            [arrays addObject:array];
+            [vectors addObject:vector];
+        }
+    }
+}
+- (void)testMap {
+    KQSPersistentVector *begin = [KQSPersistentVector vectorWithArray:@[@1,@2,@3]];
+    NSArray *end = @[@"1",[NSNull null],@"3"];
+
+    XCTAssertEqualObjects([begin KQS_map:^id _Nullable(NSNumber *object, NSInteger index) {
+        return index == 1 ? nil : object.stringValue;
+    }].array, end);
+}
+- (void)testFilterReject {
+    KQSPersistentVector *begin = [KQSPersistentVector vectorWithArray:@[@1,@2,@3,@4]];
+
+    XCTAssertEqualObjects([begin KQS_filter:^BOOL(NSNumber *object, NSInteger index) {
+        return object.integerValue % 2 == 0;
+    }].array, (@[@2,@4]));
+    XCTAssertEqualObjects([begin KQS_reject:^BOOL(NSNumber *object, NSInteger index) {
+        return object.integerValue % 2 == 0;
+    }].array, (@[@1,@3]));
+}
+- (void)testTakeDrop {
+    NSArray *begin = @[@1,@2,@3];
+    KQSPersistentVector *vector = [KQSPersistentVector vectorWithArray:begin];
+
+    XCTAssertEqualObjects([vector KQS_take:2].array, [begin KQS_take:2]);
+    XCTAssertEqualObjects([vector KQS_take:4].array, [begin KQS_take:4]);
+    XCTAssertEqualObjects([vector KQS_drop:1].array, [begin KQS_drop:1]);
+    XCTAssertEqualObjects([vector KQS_drop:4].array, [begin KQS_drop:4]);
+    XCTAssertEqualObjects([vector KQS_take:-1].array, [begin KQS_take:-1]);
+    XCTAssertEqualObjects([vector KQS_drop:-1].array, [begin KQS_drop:-1]);
+    XCTAssertEqualObjects([vector KQS_takeWhile:^BOOL(NSNumber *object, NSInteger index) {
+        return object.integerValue < 3;
+    }].array, (@[@1,@2]));
+    XCTAssertEqualObjects([vector KQS_dropWhile:^BOOL(NSNumber *object, NSInteger index) {
+        return object.integerValue < 2;
+    }].array, (@[@2,@3]));
+}
+- (void)testZip {
+    KQSPersistentVector *first = [KQSPersistentVector vectorWithArray:@[@1,@2,@3]];
+    KQSPersistentVector *second = [KQSPersistentVector vectorWithArray:@[@3,@4]];
+    NSArray *end = @[@[@1,@3],@[@2,@4]];
+
+    XCTAssertEqualObjects([first KQS_zip:second].array, end);
+}
+- (void)testFindWithIndex {
+    KQSPersistentVector *begin = [KQSPersistentVector vectorWithArray:@[@1,@2,@3]];
+
+    XCTAssertEqualObjects([begin KQS_findWithIndex:^BOOL(NSNumber *object, NSInteger index) {
+        return object.integerValue > 1;
+    }], (@[@2,@1]));
+    XCTAssertNil([begin KQS_findWithIndex:^BOOL(NSNumber *object, NSInteger index) {
+        return NO;
+    }]);
+}
+- (void)testReduce {
+    KQSPersistentVector *begin = [KQSPersistentVector vectorWithArray:@[@1,@2,@3]];
+
+    XCTAssertEqual([begin KQS_reduceIntegerWithStart:1 block:^NSInteger(NSInteger sum, NSNumber *object, NSInteger index) {
+        return sum + object.integerValue;
+    }], 7);
+    XCTAssertEqualWithAccuracy([begin KQS_reduceFloatWithStart:0.5 block:^CGFloat(CGFloat sum, NSNumber *object, NSInteger index) {
+        return sum + object.doubleValue;
+    }], 6.5, 0.0001);
+}
+- (void)testFlatten {
+    KQSPersistentVector *begin = [KQSPersistentVector vectorWithArray:@[@1,@[@2,@[@3]],[KQSPersistentVector vectorWithArray:@[@4,@[@5]]]]];
+
+    XCTAssertEqualObjects([begin KQS_flatten].array, (@[@1,@2,@3,@4,@5]));
+}
+- (void)testAggregates {
+    NSArray *numbers = @[@3,@1,@2];
+    NSArray *doubles = @[@1.5,@2.0,@0.5];
+    NSArray *decimals = @[[NSDecimalNumber decimalNumberWithString:@"1.5"],[NSDecimalNumber decimalNumberWithString:@"2"]];
+
+    for (NSArray *begin in @[numbers,doubles,decimals]) {
+        KQSPersistentVector *vector = [KQSPersistentVector vectorWithArray:begin];
+
+        XCTAssertEqualObjects([vector KQS_sum], [begin KQS_sum]);
+        XCTAssertEqualObjects([vector KQS_sumPrecise], [begin KQS_sumPrecise]);
+        XCTAssertEqualObjects([vector KQS_product], [begin KQS_product]);
+        XCTAssertEqualObjects([vector KQS_maximum], [begin KQS_maximum]);
+        XCTAssertEqualObjects([vector KQS_minimum], [begin KQS_minimum]);
+    }
+
+    XCTAssertEqualObjects([[KQSPersistentVector vector] KQS_sum], @0);
+    XCTAssertNil([[KQSPersistentVector vector] KQS_maximum]);
+}
+
+@end
@@ -0,0 +1,167 @@
+//
+//  KQSRandomTestCase.m
+//  QuicksilverTests-iOS
+//
+//  Created by William Towe on 10/19/26.
+//  Copyright © 2021 Kosoku Interactive, LLC. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+
+#import <XCTest/XCTest.h>
+
+#import <Quicksilver/Quicksilver.h>
+
+@interface KQSRandomTestCase : XCTestCase
+
+@end
+
+@implementation KQSRandomTestCase
+
+- (void)testSeed {
+    KQSRandom *first = [[KQSRandom alloc] initWithSeed:42];
+    KQSRandom *second = [[KQSRandom alloc] initWithSeed:42];
+    KQSRandom *third = [[KQSRandom alloc] initWithSeed:43];
+    
+    XCTAssertEqual(first.seed, 42);
+    
+    for (NSInteger i=0; i<100; i++) {
+        uint64_t value = [first nextValue];
+        
+        XCTAssertEqual(value, [second nextValue]);
+        XCTAssertNotEqual(value, [third nextValue]);
+    }
+    
+    XCTAssertNotEqual([[KQSRandom alloc] init].seed, [[KQSRandom alloc] init].seed);
+}
+- (void)testNextValueBelow {
+    KQSRandom *random = [[KQSRandom alloc] initWithSeed:1];
+    NSUInteger counts[3] = {0};
+    
+    for (NSInteger i=0; i<30000; i++) {
+        NSUInteger value = [random nextValueBelow:3];
+        
+        XCTAssertLessThan(value, 3);
+        
+        counts[value]++;
+    }
+    
+    for (NSInteger i=0; i<3; i++) {
+        XCTAssertEqualWithAccuracy((double)counts[i], 10000, 500);
+    }
+    
+    XCTAssertEqual([random nextValueBelow:1], 0);
+    XCTAssertThrows([random nextValueBelow:0]);
+}
+- (void)testNextDouble {
+    KQSRandom *random = [[KQSRandom alloc] initWithSeed:2];
+    double sum = 0.0;
+    
+    for (NSInteger i=0; i<10000; i++) {
+        double value = [random nextDouble];
+        
+        XCTAssertGreaterThanOrEqual(value, 0.0);
+        XCTAssertLessThan(value, 1.0);
+        
+        sum += value;
+    }
+    
+    XCTAssertEqualWithAccuracy(sum / 10000.0, 0.5, 0.02);
+}
+- (void)testGetIndexes {
+    KQSRandom *random = [[KQSRandom alloc] initWithSeed:3];
+    NSUInteger indexes[100];
+    
+    // sparse, the bound is far larger than the count
+    [random getIndexes:indexes count:100 below:NSUIntegerMax / 2];
+    
+    NSMutableIndexSet *distinct = [[NSMutableIndexSet alloc] init];
+    
+    for (NSInteger i=0; i<100; i++) {
+        XCTAssertLessThan(indexes[i], NSUIntegerMax / 2);
+        
+        [distinct addIndex:indexes[i]];
+    }
+    
+    XCTAssertEqual(distinct.count, 100);
+    
+    // dense, every index is chosen
+    [random getIndexes:indexes count:100 below:100];
+    [distinct removeAllIndexes];
+    
+    for (NSInteger i=0; i<100; i++) {
+        [distinct addIndex:indexes[i]];
+    }
+    
+    XCTAssertEqualObjects(distinct, [NSIndexSet indexSetWithIndexesInRange:NSMakeRange(0, 100)]);
+    XCTAssertThrows([random getIndexes:indexes count:2 below:1]);
+}
+- (void)testSampleObjects {
+    KQSRandom *random = [[KQSRandom alloc] initWithSeed:4];
+    NSMutableArray *objects = [[NSMutableArray alloc] init];
+    NSUInteger counts[20] = {0};
+    
+    for (NSInteger i=0; i<20; i++) {
+        [objects addObject:@(i)];
+    }
+    
+    // every object is equally likely to be chosen, wherever it is in the stream
+    for (NSInteger i=0; i<10000; i++) {
+        NSArray<NSNumber *> *sample = [random sampleObjects:objects.objectEnumerator count:5];
+        
+        XCTAssertEqual(sample.count, 5);
+        XCTAssertEqual([NSSet setWithArray:sample].count, 5);
+        
+        for (NSNumber *number in sample) {
+            counts[number.integerValue]++;
+        }
+    }
+    
+    for (NSInteger i=0; i<20; i++) {
+        XCTAssertEqualWithAccuracy((double)counts[i], 2500, 250);
+    }
+    
+    XCTAssertEqualObjects([NSSet setWithArray:[random sampleObjects:objects count:100]], [NSSet setWithArray:objects]);
+    XCTAssertEqualObjects([random sampleObjects:objects count:0], @[]);
+    XCTAssertEqualObjects([random sampleObjects:@[] count:3], @[]);
+}
+- (void)testSampleObjectsWeighted {
+    KQSRandom *random = [[KQSRandom alloc] initWithSeed:5];
+    NSArray *objects = @[@"a",@"b",@"c",@"d"];
+    NSArray *weights = @[@1.0,@3.0,@0.0,@-1.0];
+    NSMutableDictionary<NSString *, NSNumber *> *counts = [[NSMutableDictionary alloc] init];
+    
+    for (NSInteger i=0; i<10000; i++) {
+        NSArray *sample = [random sampleObjects:objects count:1 weight:^double(id object, NSInteger index) {
+            return [weights[index] doubleValue];
+        }];
+        
+        XCTAssertEqual(sample.count, 1);
+        
+        counts[sample.firstObject] = @(counts[sample.firstObject].integerValue + 1);
+    }
+    
+    XCTAssertEqualWithAccuracy(counts[@"a"].integerValue, 2500, 250);
+    XCTAssertEqualWithAccuracy(counts[@"b"].integerValue, 7500, 250);
+    XCTAssertNil(counts[@"c"]);
+    XCTAssertNil(counts[@"d"]);
+    
+    // only the objects with a positive weight can be chosen
+    NSArray *sample = [random sampleObjects:objects count:4 weight:^double(id object, NSInteger index) {
+        return [weights[index] doubleValue];
+    }];
+    
+    XCTAssertEqualObjects([NSSet setWithArray:sample], ([NSSet setWithArray:@[@"a",@"b"]]));
+}
+
+@end
@@ -0,0 +1,23 @@
+#!/bin/sh
+# Builds the differential harness in QuicksilverTests/KQSDifferentialHarness.m and KQSDifferentialHarness+KQSCpp.mm against GNUstep and runs it headless, e.g. on a Linux CI host.
+# Requires clang, gnustep-base built against libobjc2 and libdispatch.
+# KQS_DIFFERENTIAL_SEED and KQS_DIFFERENTIAL_ITERATIONS are passed through to the harness.
+
+set -e
+
+ROOT=$(cd "$(dirname "$0")/.." && pwd)
+BUILD=$(mktemp -d)
+
+trap 'rm -rf "$BUILD"' EXIT
+
+# the framework headers are imported as <Quicksilver/...> and import CoreGraphics for CGFloat, which GNUstep declares in Foundation
+mkdir -p "$BUILD/include/CoreGraphics"
+ln -s "$ROOT/Quicksilver" "$BUILD/include/Quicksilver"
+printf '#import <Foundation/Foundation.h>\n' > "$BUILD/include/CoreGraphics/CGBase.h"
+
+# the checks of the KQSCpp.h templates are Objective-C++, hence -lstdc++
+clang -O2 -fobjc-arc -fblocks $(gnustep-config --objc-flags) -I"$BUILD/include" -DKQS_DIFFERENTIAL_MAIN \
+    "$ROOT"/Quicksilver/*.m "$ROOT/QuicksilverTests/KQSDifferentialHarness.m" "$ROOT/QuicksilverTests/KQSDifferentialHarness+KQSCpp.mm" \
+    $(gnustep-config --base-libs) -ldispatch -lm -lstdc++ -o "$BUILD/differential"
+
+"$BUILD/differential"